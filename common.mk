@@ -38,7 +38,13 @@ CXXFLAGS:=-O2 -g -std=c++11 -I${HALIDE_BUILD}/include -I${HALIDE_ROOT}/tools -L$
 CSIM_CXXFLAGS:=-O2 -g -std=c++11 -I${HALIDE_BUILD}/include -I${HALIDE_ROOT}/tools -L${HALIDE_LIB_DIR} -I../../include
 LIBS:=-ldl -lpthread -lz
 
-.PHONY: clean
+# Extra generator params for host build, e.g. GEN_PARAMS="cpu_schedule=tile"
+# Params which ${PROG}_generator.cc does not declare are dropped, so that GEN_PARAMS can be given
+# to all modules at once, e.g. GEN_PARAMS="cpu_schedule=tile" ./testall.sh
+GEN_PARAMS?=
+MODULE_GEN_PARAMS=$(foreach p,${GEN_PARAMS},$(if $(shell grep -s '"$(firstword $(subst =, ,${p}))"' ${PROG}_generator.cc),${p}))
+
+.PHONY: clean bench profile trace
 
 all: ${PROG}_test
 
@@ -48,15 +54,15 @@ ${PROG}_gen: ${PROG}_generator.cc
 ${PROG}_gen.exec: ${PROG}_gen
 ifdef TYPE_LIST
 ifeq ($(OS), Linux)
-	$(foreach type,${TYPE_LIST},LD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o . -g ${PROG}_${type} -e h,static_library target=x86-64-no_asserts;)
+	$(foreach type,${TYPE_LIST},LD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o . -g ${PROG}_${type} -e h,static_library target=x86-64-no_asserts ${MODULE_GEN_PARAMS};)
 else
-	$(foreach type,${TYPE_LIST},DYLD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o . -g ${PROG}_${type} -e h,static_library target=x86-64-no_asserts;)
+	$(foreach type,${TYPE_LIST},DYLD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o . -g ${PROG}_${type} -e h,static_library target=x86-64-no_asserts ${MODULE_GEN_PARAMS};)
 endif
 else
 ifeq ($(OS), Linux)
-	LD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o . -g ${PROG} -e h,static_library target=host-no_asserts
+	LD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o . -g ${PROG} -e h,static_library target=host-no_asserts ${MODULE_GEN_PARAMS}
 else
-	DYLD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o .  -g ${PROG} -e h,static_library target=host-no_asserts
+	DYLD_LIBRARY_PATH=${HALIDE_LIB_DIR} ./$< -o .  -g ${PROG} -e h,static_library target=host-no_asserts ${MODULE_GEN_PARAMS}
 endif
 endif
 	@touch ${PROG}_gen.exec
@@ -68,6 +74,13 @@ $(foreach type,${TYPE_LIST},${PROG}_${type}.h): ${PROG}_gen.exec
 
 ${PROG}_test: ${PROG}_test.cc $(foreach type,${TYPE_LIST},${PROG}_${type}.h ${PROG}_${type}.a)
 	g++ $(foreach type,${TYPE_LIST},-DTYPE_${type}) -I . ${CXXFLAGS} $< -o $@ $(foreach type,${TYPE_LIST},${PROG}_${type}.a) -ldl -lpthread
+
+# Each variant gets its own benchmark binary, so that results are named after the variant
+define bench_template
+${PROG}_bench_$(1): ${PROG}_test.cc ${PROG}_$(1).h ${PROG}_$(1).a
+	g++ -DTYPE_$(1) -DHALIDE_ELEMENT_BENCH -DBENCH_NAME=\"${PROG}\" -DBENCH_VARIANT=\"$(1)\" -I . ${CXXFLAGS} $$< -o $$@ ${PROG}_$(1).a -ldl -lpthread
+endef
+$(foreach type,${TYPE_LIST},$(eval $(call bench_template,${type})))
 else
 ${PROG}.a: ${PROG}_gen.exec
 
@@ -75,11 +88,55 @@ ${PROG}.h: ${PROG}_gen.exec
 
 ${PROG}_test: ${PROG}_test.cc ${PROG}.h ${PROG}.a
 	g++ -I . ${CXXFLAGS} $< -o $@ ${PROG}.a -ldl -lpthread
+
+${PROG}_bench: ${PROG}_test.cc ${PROG}.h ${PROG}.a
+	g++ -DHALIDE_ELEMENT_BENCH -DBENCH_NAME=\"${PROG}\" -I . ${CXXFLAGS} $< -o $@ ${PROG}.a -ldl -lpthread
 endif
 
 test: ${PROG}_test
 	./${PROG}_test
 
+# Benchmark, e.g. BENCH_ITERATIONS=1000 make bench
+ifdef TYPE_LIST
+bench: $(foreach type,${TYPE_LIST},${PROG}_bench_${type})
+	$(foreach type,${TYPE_LIST},BENCH_JSON=${PROG}_${type}_bench.json ./${PROG}_bench_${type} &&) true
+else
+bench: ${PROG}_bench
+	BENCH_JSON=${PROG}_bench.json ./${PROG}_bench
+endif
+
+# Instrumented variants
+#   make profile : Halide profiler, per-Func time and memory are reported when the test exits
+#   make trace   : Halide tracing, set HL_TRACE_FILE to write binary trace instead of text
+TRACE_FEATURES?=trace_stores
+ifeq ($(OS), Linux)
+	LIBRARY_PATH_ENV=LD_LIBRARY_PATH
+else
+	LIBRARY_PATH_ENV=DYLD_LIBRARY_PATH
+endif
+ifdef TYPE_LIST
+	VARIANT_LIBS=$(foreach type,${TYPE_LIST},${PROG}_${type})
+	VARIANT_TARGET=x86-64-no_asserts
+else
+	VARIANT_LIBS=${PROG}
+	VARIANT_TARGET=host-no_asserts
+endif
+
+define variant_template
+$(1)/${PROG}_gen.exec: ${PROG}_gen
+	mkdir -p $(1)
+	$(foreach lib,${VARIANT_LIBS},${LIBRARY_PATH_ENV}=${HALIDE_LIB_DIR} ./$$< -o $(1) -g ${lib} -e h,static_library target=${VARIANT_TARGET}-$(2) ${MODULE_GEN_PARAMS};)
+	@touch $$@
+
+${PROG}_test_$(1): ${PROG}_test.cc $(1)/${PROG}_gen.exec
+	g++ $(foreach type,${TYPE_LIST},-DTYPE_${type}) -I $(1) -I . ${CXXFLAGS} $$< -o $$@ $(foreach lib,${VARIANT_LIBS},$(1)/${lib}.a) -ldl -lpthread
+
+$(1): ${PROG}_test_$(1)
+	./${PROG}_test_$(1)
+endef
+$(eval $(call variant_template,profile,profile))
+$(eval $(call variant_template,trace,${TRACE_FEATURES}))
+
 ${PROG}_gen.hls: ${PROG}_generator.cc
 	g++ -D HALIDE_FOR_FPGA -fno-rtti ${CXXFLAGS} $< ${HALIDE_TOOLS_DIR}/GenGen.cpp -o ${PROG}_gen.hls ${LIBS} -lHalide
 
@@ -133,4 +190,4 @@ run: ${PROG}_run.c ${PROG}.hls.exec
 	arm-linux-gnueabihf-gcc ${CFLAGS} ${TARGET_SRC} -o $@ ${TARGET_LIB}
 
 clean:
-	rm -rf ${PROG}_gen ${PROG}_test ${PROG}_*test_csim ${PROG}_run ${PROG}*.h ${PROG}*.a *.o *.hls *.exec *.dSYM *.ppm *.pgm *.dat
+	rm -rf ${PROG}_gen ${PROG}_test ${PROG}_bench ${PROG}_bench_* ${PROG}*_bench.json ${PROG}_test_profile ${PROG}_test_trace profile trace ${PROG}_*test_csim ${PROG}_run ${PROG}*.h ${PROG}*.a *.o *.hls *.exec *.dSYM *.ppm *.pgm *.dat
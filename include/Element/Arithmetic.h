@@ -2,14 +2,207 @@
 #define HALIDE_ELEMENT_ARITHMETIC_H
 
 #include "Halide.h"
+#include "Schedule.h"
 #include "Util.h"
 #include<cstdio>
+#include <functional>
+#include <limits>
+#include <type_traits>
 
 namespace Halide {
 namespace Element {
 
 namespace {
 
+// On CPU, full-frame reductions are computed in parallel. Rows are split into strips of
+// reduction_strip_rows, each strip is reduced column by column into its own partial row with
+// the loop vectorized across x, and the partial rows are merged at the end.
+const int32_t reduction_strip_rows = 32;
+const int32_t reduction_lanes = 8;
+
+enum class ReductionOp {
+    Sum,
+    Min,
+    Max
+};
+
+Expr reduction_identity(ReductionOp op, Type type)
+{
+    switch (op) {
+    case ReductionOp::Min:
+        return type.max();
+    case ReductionOp::Max:
+        return type.min();
+    default:
+        return make_zero(type);
+    }
+}
+
+Expr reduction_update(ReductionOp op, Expr a, Expr b)
+{
+    switch (op) {
+    case ReductionOp::Min:
+        return min(a, b);
+    case ReductionOp::Max:
+        return max(a, b);
+    default:
+        return a + b;
+    }
+}
+
+// Reduces value(x, y) over [0, width) x [0, height) into dst(0).
+// insert(partial, value) accumulates a value into a partial result, and merge(partial, partial) combines
+// two partial results; merge must be associative and commutative. identity has the types of the partial result.
+// width and height may be runtime values.
+Func strip_reduce(Func value, Expr width, Expr height,
+                  std::function<Tuple(Tuple, Tuple)> insert, std::function<Tuple(Tuple, Tuple)> merge, Tuple identity,
+                  const std::string& name)
+{
+    Expr strips = (height + reduction_strip_rows - 1) / reduction_strip_rows;
+    Var x{"x"}, s{"s"};
+
+    RDom r{0, reduction_strip_rows, name + "_r"};
+    Expr row = s * reduction_strip_rows + r;
+    r.where(row < height);
+    row = min(row, height - 1);
+
+    Func partial{name + "_partial"};
+    partial(x, s) = identity;
+    partial(x, s) = insert(Tuple(partial(x, s)), Tuple(value(x, row)));
+
+    RDom rs{0, strips, name + "_rs"};
+    Func column{name + "_column"};
+    column(x) = identity;
+    column(x) = merge(Tuple(column(x)), Tuple(partial(x, rs)));
+
+    RDom rx{0, width, name + "_rx"};
+    Func dst{name};
+    dst(x) = identity;
+    dst(x) = merge(Tuple(dst(x)), Tuple(column(rx)));
+
+    // Guarded vectorization never touches x >= width, which may be outside of the image.
+    partial.compute_root().parallel(s).vectorize(x, reduction_lanes, TailStrategy::GuardWithIf);
+    partial.update().reorder(x, r, s).parallel(s).vectorize(x, reduction_lanes, TailStrategy::GuardWithIf);
+    column.compute_root().vectorize(x, reduction_lanes, TailStrategy::GuardWithIf);
+    column.update().reorder(x, rs).vectorize(x, reduction_lanes, TailStrategy::GuardWithIf);
+    schedule(dst, {1});
+
+    return dst;
+}
+
+// Same as above, where value has the types of the partial result.
+Func strip_reduce(Func value, Expr width, Expr height, std::function<Tuple(Tuple, Tuple)> merge, Tuple identity,
+                  const std::string& name)
+{
+    return strip_reduce(value, width, height, merge, merge, identity, name);
+}
+
+Func strip_reduce(Func value, Expr width, Expr height, ReductionOp op, Expr identity, const std::string& name)
+{
+    auto merge = [op](Tuple a, Tuple b) {
+        return Tuple(reduction_update(op, a[0], b[0]));
+    };
+    return strip_reduce(value, width, height, merge, Tuple(identity), name);
+}
+
+// ROI reductions. res(0) is a Tuple {count, value} of the pixels in the ROI, reduced by op in one pass.
+// For ReductionOp::Sum, the value is accumulated in 64-bit (integer pixels) or double (floating-point pixels).
+
+Type roi_reduction_type(ReductionOp op, Type type)
+{
+    if (op != ReductionOp::Sum) {
+        return type;
+    }
+    return type.is_float() ? Float(64) : type.is_int() ? Int(64) : UInt(64);
+}
+
+Tuple roi_merge(ReductionOp op, Tuple a, Tuple b)
+{
+    return Tuple(a[0] + b[0], reduction_update(op, a[1], b[1]));
+}
+
+// The ROI is the pixels in the box [x0, x0 + w) x [y0, y0 + h) where roi is not 0.
+// The box is clipped to the width x height frame, and pixels outside of it are never visited.
+Func roi_box_reduce(Func src, Func roi, int32_t width, int32_t height, Expr x0, Expr y0, Expr w, Expr h,
+                    ReductionOp op, const std::string& name)
+{
+    Var x{"x"}, y{"y"};
+
+    Expr bx0 = clamp(x0, 0, width);
+    Expr by0 = clamp(y0, 0, height);
+    Expr bw = max(clamp(x0 + w, 0, width) - bx0, 0);
+    Expr bh = max(clamp(y0 + h, 0, height) - by0, 0);
+
+    const Type type = roi_reduction_type(op, src.output_types()[0]);
+    Expr identity = reduction_identity(op, type);
+    Expr in = roi(bx0 + x, by0 + y) != 0;
+
+    Func value{name + "_value"};
+    value(x, y) = Tuple(select(in, cast<uint32_t>(1), cast<uint32_t>(0)),
+                        select(in, cast(type, src(bx0 + x, by0 + y)), identity));
+
+    auto merge = [op](Tuple a, Tuple b) {
+        return roi_merge(op, a, b);
+    };
+
+    return strip_reduce(value, bw, bh, merge, Tuple(cast<uint32_t>(0), identity), name);
+}
+
+// The ROI is given by run-length encoded spans: spans(0, i), spans(1, i) and spans(2, i) are
+// x, y and the length of the i-th span, for i in [0, num_spans). No span may be longer than max_span_width.
+// Spans are reduced in parallel chunks of reduction_strip_rows, and only the pixels of the spans are visited;
+// the loop over a span stops at its length. Pixels of a span outside of the width x height frame are skipped,
+// and num_spans may be 0.
+Func roi_spans_reduce(Func src, int32_t width, int32_t height, Func spans, Expr num_spans, int32_t max_span_width,
+                      ReductionOp op, const std::string& name)
+{
+    Var x{"x"}, s{"s"};
+
+    const Type type = roi_reduction_type(op, src.output_types()[0]);
+    Expr identity = reduction_identity(op, type);
+
+    RDom r{0, max_span_width, 0, reduction_strip_rows, name + "_r"};
+    Expr i = s * reduction_strip_rows + r.y;
+    r.where(i < num_spans);
+    i = clamp(i, 0, max(num_spans - 1, 0));
+    Expr px = spans(0, i) + r.x;
+    Expr py = spans(1, i);
+    r.where(r.x < spans(2, i));
+    r.where(0 <= px && px < width && 0 <= py && py < height);
+
+    // The coordinates are also clamped, since bounds inference does not see the conditions above
+    Func partial{name + "_partial"};
+    partial(s) = Tuple(cast<uint32_t>(0), identity);
+    partial(s) = roi_merge(op, Tuple(partial(s)),
+                           Tuple(cast<uint32_t>(1), cast(type, src(clamp(px, 0, width - 1), clamp(py, 0, height - 1)))));
+
+    RDom rs{0, (num_spans + reduction_strip_rows - 1) / reduction_strip_rows, name + "_rs"};
+    Func dst{name};
+    dst(x) = Tuple(cast<uint32_t>(0), identity);
+    dst(x) = roi_merge(op, Tuple(dst(x)), Tuple(partial(rs)));
+
+    partial.compute_root().parallel(s);
+    partial.update().parallel(s);
+    schedule(dst, {1});
+
+    return dst;
+}
+
+// Final value of min_value, max_value or average_value from res(0) = {count, value}.
+template<typename T>
+Func roi_value(Func res, ReductionOp op)
+{
+    Var x{"x"};
+
+    Tuple t(res(0));
+    Expr v = op == ReductionOp::Sum ? cast<double>(t[1]) / t[0] : t[1];
+
+    Func dst;
+    dst(x) = cast<T>(select(t[0] == cast<uint32_t>(0), make_zero(v.type()), v));
+
+    return dst;
+}
+
 template<typename T, typename D>
 Func sq_sum(ImageParam src, int32_t width, int32_t height)
 {
@@ -17,6 +210,18 @@ Func sq_sum(ImageParam src, int32_t width, int32_t height)
 
     Func dst("sq_sum");
 
+#if !defined(HALIDE_FOR_FPGA)
+    // Squares of integer pixels are summed exactly in uint64 as long as the total fits in it.
+    const double max_total = static_cast<double>(std::numeric_limits<T>::max()) * std::numeric_limits<T>::max() * width * height;
+    if (std::is_integral<T>::value && max_total < 18446744073709551616.0) {
+        Func value{"sq_sum_value"};
+        value(x, y) = cast<uint64_t>(src(x, y)) * cast<uint64_t>(src(x, y));
+        Func total = strip_reduce(value, width, height, ReductionOp::Sum, cast<uint64_t>(0), "sq_sum_total");
+        dst(x, y) = cast<D>(total(0));
+        return dst;
+    }
+#endif
+
     RDom r(0, width, 0, height);
 
     dst(x, y) = cast<D>(sum(cast<double>(src(r.x, r.y)) * cast<double>(src(r.x, r.y))));
@@ -31,6 +236,18 @@ Func sum(ImageParam src, int32_t width, int32_t height)
 
     Func dst("sum");
 
+#if !defined(HALIDE_FOR_FPGA)
+    // Integer sums are exact, so they are reduced in parallel.
+    // Floating-point sums stay sequential to keep the order of additions.
+    if (std::is_integral<T>::value) {
+        Func value{"sum_value"};
+        value(x, y) = cast<typename SumType<T>::type>(src(x, y));
+        Func total = strip_reduce(value, width, height, ReductionOp::Sum, cast<typename SumType<T>::type>(0), "sum_total");
+        dst(x, y) = cast<D>(total(0));
+        return dst;
+    }
+#endif
+
     RDom r(0, width, 0, height);
 
     dst(x, y) = cast<D>(sum(cast<typename SumType<T>::type>(src(r.x, r.y))));
@@ -175,9 +392,135 @@ Func min(Func src0, Func src1)
     return dst;
 }
 
+// Whether (v0, i0) comes before (v1, i1) in the order of argmax (is_max) or argmin (!is_max).
+// Ties of the value are broken by the smaller raster-order index, i.e. the first occurrence wins.
+Expr arg_better(Expr v0, Expr i0, Expr v1, Expr i1, bool is_max)
+{
+    return (is_max ? v0 > v1 : v0 < v1) || (v0 == v1 && i0 < i1);
+}
+
+// Position of the first minimum (!is_max) or maximum (is_max) of src as res(0) = {value, y * width + x},
+// reduced in parallel strips.
+Func arg_extremum(Func src, int32_t width, int32_t height, bool is_max, const std::string& name)
+{
+    Var x{"x"}, y{"y"};
+
+    const Type type = src.output_types()[0];
+    Expr worst = is_max ? type.min() : type.max();
+    Expr none = UInt(32).max();
+
+    Func value{name + "_value"};
+    value(x, y) = Tuple(src(x, y), cast<uint32_t>(y * width + x));
+
+    auto merge = [is_max](Tuple a, Tuple b) {
+        Expr take = arg_better(b[0], b[1], a[0], a[1], is_max);
+        return Tuple(select(take, b[0], a[0]), select(take, b[1], a[1]));
+    };
+
+    return strip_reduce(value, width, height, merge, Tuple(worst, none), name);
+}
+
+// Positions of the k best pixels, sorted from the best. Pixels are ordered by the value (descending if is_max,
+// ascending otherwise), and pixels of the same value by raster order.
+// dst(0, i) and dst(1, i) are x and y of the i-th position.
+Func pos_topk(Func src, int32_t width, int32_t height, int32_t k, bool is_max)
+{
+    throw_assert(k > 0 && k <= width * height, "k must be in [1, width * height].");
+
+    Var x{"x"}, y{"y"};
+
+    const Type type = src.output_types()[0];
+    Expr worst = is_max ? type.min() : type.max();
+    Expr none = UInt(32).max();
+
+    // A partial result is a Tuple of k values followed by their k indices, sorted from the best.
+    Tuple identity(std::vector<Expr>(2 * k));
+    for (int32_t i=0; i<k; ++i) {
+        identity[i] = worst;
+        identity[k + i] = none;
+    }
+
+    // Inserts a pixel {value, index} into a sorted list.
+    auto insert = [k, is_max](Tuple a, Tuple p) {
+        Tuple res(std::vector<Expr>(2 * k));
+        for (int32_t i=0; i<k; ++i) {
+            Expr here = arg_better(p[0], p[1], a[i], a[k + i], is_max);
+            if (i == 0) {
+                res[i] = select(here, p[0], a[i]);
+                res[k + i] = select(here, p[1], a[k + i]);
+            } else {
+                // The pixel goes to the first slot it beats, and the following ones shift down by one.
+                Expr above = arg_better(p[0], p[1], a[i - 1], a[k + i - 1], is_max);
+                res[i] = select(!here, a[i], select(above, a[i - 1], p[0]));
+                res[k + i] = select(!here, a[k + i], select(above, a[k + i - 1], p[1]));
+            }
+        }
+        return res;
+    };
+
+    // Merges two sorted lists. The i-th of the result is the best of worse(a[j-1], b[i-j]) over j in [0, i+1],
+    // where a[-1] and b[-1] are regarded as better than anything.
+    auto merge = [k, is_max](Tuple a, Tuple b) {
+        Tuple res(std::vector<Expr>(2 * k));
+        for (int32_t i=0; i<k; ++i) {
+            Expr v, idx;
+            for (int32_t j=0; j<=i+1; ++j) {
+                Expr cv, ci;
+                if (j == 0) {
+                    cv = b[i];
+                    ci = b[k + i];
+                } else if (j == i + 1) {
+                    cv = a[i];
+                    ci = a[k + i];
+                } else {
+                    Expr a_better = arg_better(a[j - 1], a[k + j - 1], b[i - j], b[k + i - j], is_max);
+                    cv = select(a_better, b[i - j], a[j - 1]);
+                    ci = select(a_better, b[k + i - j], a[k + j - 1]);
+                }
+                if (j == 0) {
+                    v = cv;
+                    idx = ci;
+                } else {
+                    Expr take = arg_better(cv, ci, v, idx, is_max);
+                    v = select(take, cv, v);
+                    idx = select(take, ci, idx);
+                }
+            }
+            res[i] = v;
+            res[k + i] = idx;
+        }
+        return res;
+    };
+
+    Func value{"topk_value"};
+    value(x, y) = Tuple(src(x, y), cast<uint32_t>(y * width + x));
+
+    Func res;
+#if defined(HALIDE_FOR_FPGA)
+    RDom r{0, width, 0, height, "r"};
+    res(x) = identity;
+    res(x) = insert(Tuple(res(x)), Tuple(value(r.x, r.y)));
+    schedule(res, {1});
+#else
+    res = strip_reduce(value, width, height, insert, merge, identity, "topk");
+#endif
+
+    Var d{"d"}, i{"i"};
+    Expr idx = res(0)[k];
+    for (int32_t j=1; j<k; ++j) {
+        idx = select(i == j, res(0)[k + j], idx);
+    }
+
+    Func dst{"dst"};
+    dst(d, i) = select(d == 0, idx % cast<uint32_t>(width), idx / cast<uint32_t>(width));
+
+    return dst;
+}
+
 Func min_pos(Func src, int32_t width, int32_t height)
 {
     Var x{"x"};
+#if defined(HALIDE_FOR_FPGA)
     RDom r{0, width, 0, height, "r"};
 
     Func res{"res"};
@@ -189,15 +532,30 @@ Func min_pos(Func src, int32_t width, int32_t height)
     dst(d) = cast<uint32_t>(0);
     dst(0) = cast<uint32_t>(res(0)[0]);
     dst(1) = cast<uint32_t>(res(0)[1]);
+#else
+    Func res = arg_extremum(src, width, height, false, "res");
+
+    Var d{"d"};
+    Func dst{"dst"};
+    Expr idx = res(0)[1];
+    dst(d) = select(d == 0, idx % cast<uint32_t>(width), idx / cast<uint32_t>(width));
+#endif
 
     return dst;
 }
 
+// Positions of the k smallest pixels. See pos_topk.
+Func min_pos_topk(Func src, int32_t width, int32_t height, int32_t k)
+{
+    return pos_topk(src, width, height, k, false);
+}
+
 template<typename T>
 Func min_value(Func src, Func roi, int32_t width, int32_t height)
 {
     Var x{"x"};
     Func count{"count"}, dst;
+#if defined(HALIDE_FOR_FPGA)
     RDom r{0, width, 0, height, "r"};
     r.where(roi(r.x, r.y) != 0);
 
@@ -205,6 +563,9 @@ Func min_value(Func src, Func roi, int32_t width, int32_t height)
     schedule(count, {1});
 
     dst(x) = cast<T>(select(count(x) == 0, 0, minimum(src(r.x, r.y))));
+#else
+    dst = roi_value<T>(roi_box_reduce(src, roi, width, height, 0, 0, width, height, ReductionOp::Min, "res"), ReductionOp::Min);
+#endif
 
     return dst;
 }
@@ -222,6 +583,7 @@ Func max(Func src0, Func src1)
 Func max_pos(Func src, int32_t width, int32_t height)
 {
     Var x{"x"};
+#if defined(HALIDE_FOR_FPGA)
     RDom r{0, width, 0, height, "r"};
 
     Func res{"res"};
@@ -233,15 +595,30 @@ Func max_pos(Func src, int32_t width, int32_t height)
     dst(d) = cast<uint32_t>(0);
     dst(0) = cast<uint32_t>(res(0)[0]);
     dst(1) = cast<uint32_t>(res(0)[1]);
+#else
+    Func res = arg_extremum(src, width, height, true, "res");
+
+    Var d{"d"};
+    Func dst;
+    Expr idx = res(0)[1];
+    dst(d) = select(d == 0, idx % cast<uint32_t>(width), idx / cast<uint32_t>(width));
+#endif
 
     return dst;
 }
 
+// Positions of the k largest pixels. See pos_topk.
+Func max_pos_topk(Func src, int32_t width, int32_t height, int32_t k)
+{
+    return pos_topk(src, width, height, k, true);
+}
+
 template<typename T>
 Func max_value(Func src, Func roi, int32_t width, int32_t height)
 {
     Var x{"x"};
     Func count{"count"}, dst;
+#if defined(HALIDE_FOR_FPGA)
     RDom r{0, width, 0, height, "r"};
     r.where(roi(r.x, r.y) != 0);
 
@@ -249,10 +626,88 @@ Func max_value(Func src, Func roi, int32_t width, int32_t height)
     schedule(count, {1});
 
     dst(x) = cast<T>(select(count(x) == 0, 0, maximum(src(r.x, r.y))));
+#else
+    dst = roi_value<T>(roi_box_reduce(src, roi, width, height, 0, 0, width, height, ReductionOp::Max, "res"), ReductionOp::Max);
+#endif
+
+    return dst;
+}
+
+// Merges two partial statistics of image_stats.
+// Ties of min and max are broken by the smaller index, so that the result does not depend on the merge order.
+Tuple merge_stats(Tuple a, Tuple b)
+{
+    Expr take_min = arg_better(b[3], b[5], a[3], a[5], false);
+    Expr take_max = arg_better(b[4], b[6], a[4], a[6], true);
+
+    return Tuple(a[0] + b[0], a[1] + b[1], a[2] + b[2],
+                 select(take_min, b[3], a[3]), select(take_max, b[4], a[4]),
+                 select(take_min, b[5], a[5]), select(take_max, b[6], a[6]));
+}
+
+// Statistics of the pixels in roi, computed in a single traversal of the image.
+// dst(0) is a Tuple of {count, sum, sum of squares, min, max, argmin, argmax}.
+// count is uint32_t, sum and sum of squares are uint64_t, and min and max are T.
+// argmin and argmax are the raster-order index (y * width + x) of the first pixel taking min or max.
+// All elements are 0 if roi has no pixels.
+template<typename T>
+Func image_stats(Func src, Func roi, int32_t width, int32_t height)
+{
+    const double max_value = static_cast<double>(std::numeric_limits<T>::max());
+    throw_assert(std::numeric_limits<T>::is_integer, "image_stats supports integer types only.");
+    throw_assert(max_value * max_value * width * height <= static_cast<double>(std::numeric_limits<uint64_t>::max()),
+                 "sum of squares overflows uint64_t");
+
+    Var x{"x"}, y{"y"};
+
+    Expr in = roi(x, y) != 0;
+    Expr v = src(x, y);
+    Expr idx = cast<uint32_t>(y * width + x);
+    Expr none = UInt(32).max();
+    Expr tmin = type_of<T>().min();
+    Expr tmax = type_of<T>().max();
+
+    Func value{"stats_value"};
+    value(x, y) = Tuple(select(in, cast<uint32_t>(1), cast<uint32_t>(0)),
+                        select(in, cast<uint64_t>(v), cast<uint64_t>(0)),
+                        select(in, cast<uint64_t>(v) * cast<uint64_t>(v), cast<uint64_t>(0)),
+                        select(in, v, tmax), select(in, v, tmin),
+                        select(in, idx, none), select(in, idx, none));
+
+    Tuple identity(cast<uint32_t>(0), cast<uint64_t>(0), cast<uint64_t>(0), tmax, tmin, none, none);
+
+    Func total;
+#if defined(HALIDE_FOR_FPGA)
+    RDom r{0, width, 0, height, "r"};
+    total(x) = identity;
+    total(x) = merge_stats(Tuple(total(x)), Tuple(value(r.x, r.y)));
+    schedule(total, {1});
+#else
+    total = strip_reduce(value, width, height, merge_stats, identity, "stats");
+#endif
+
+    Tuple t(total(0));
+    Expr empty = t[0] == cast<uint32_t>(0);
+    Func dst{"dst"};
+    dst(x) = Tuple(t[0], t[1], t[2],
+                   select(empty, cast<T>(0), t[3]), select(empty, cast<T>(0), t[4]),
+                   select(empty, cast<uint32_t>(0), t[5]), select(empty, cast<uint32_t>(0), t[6]));
 
     return dst;
 }
 
+// Statistics of all pixels of the image.
+template<typename T>
+Func image_stats(Func src, int32_t width, int32_t height)
+{
+    Var x{"x"}, y{"y"};
+
+    Func roi{"roi"};
+    roi(x, y) = cast<uint8_t>(1);
+
+    return image_stats<T>(src, roi, width, height);
+}
+
 template<typename T>
 Func equal(Func src0, Func src1)
 {
@@ -286,25 +741,127 @@ Func cmpge(Func src0, Func src1)
     return dst;
 }
 
+const int32_t integral_tile_width = 64;
+
 template<typename T>
 Func integral(Func in, int32_t width, int32_t height)
 {
     Var x{"x"}, y{"y"};
     Func dst{"dst"}, integral{"integral"};
+#if defined(HALIDE_FOR_FPGA)
     integral(x, y) = cast<uint64_t>(in(x, y));
 
     RDom r1{1, width - 1, 0, height, "r1"};
     integral(r1.x, r1.y) += integral(r1.x - 1, r1.y);
-
-    RDom r2{0, width, 1, height - 1, "r2"};
-    integral(r2.x, r2.y) += integral(r2.x, r2.y - 1);
+#else
+    // Rows are scanned in two levels. Tiles of integral_tile_width pixels are scanned locally,
+    // vectorized across tiles, then the carry of each tile is the prefix sum of the preceding tile totals.
+    const int32_t tw = integral_tile_width;
+    const int32_t tiles = (width + tw - 1) / tw;
+    Var xo{"xo"}, xi{"xi"};
+
+    Func local{"local"};
+    Expr px = xo * tw + xi;
+    local(xo, xi, y) = select(px < width, cast<uint64_t>(in(min(px, width - 1), y)), cast<uint64_t>(0));
+    RDom rl{1, tw - 1, "rl"};
+    local(xo, rl, y) += local(xo, rl - 1, y);
+
+    Func carry{"carry"};
+    carry(xo, y) = cast<uint64_t>(0);
+    RDom rc{1, tiles - 1, "rc"};
+    carry(rc, y) = carry(rc - 1, y) + local(rc - 1, tw - 1, y);
+
+    integral(x, y) = local(x / tw, x % tw, y) + carry(x / tw, y);
+
+    schedule(local, {tiles, tw, height});
+    schedule(carry, {tiles, height});
+    // There are only width / integral_tile_width tiles, so lanes beyond them are guarded instead of shifted inwards
+    local.parallel(y).vectorize(xo, 8, TailStrategy::GuardWithIf);
+    local.update().reorder(xo, rl, y).parallel(y).vectorize(xo, 8, TailStrategy::GuardWithIf);
+    carry.update().parallel(y);
+#endif
+
+    RDom r2{1, height - 1, "r2"};
+    integral(x, r2) += integral(x, r2 - 1);
     schedule(integral, {width, height});
+#if !defined(HALIDE_FOR_FPGA)
+    // Columns are scanned vectorized across x, and strips of columns in parallel
+    Var cxo{"cxo"}, cxi{"cxi"};
+    integral.parallel(y).vectorize(x, 8, TailStrategy::GuardWithIf);
+    integral.update(0).split(x, cxo, cxi, 64, TailStrategy::GuardWithIf).reorder(cxi, r2, cxo).parallel(cxo)
+        .vectorize(cxi, 8, TailStrategy::GuardWithIf);
+#endif
 
     dst(x, y) = cast<T>(integral(x, y));
 
     return dst;
 }
 
+// Inclusive summed area table of each value of the Tuple, scanned in a single pass over the image
+Func summed_area_table(Tuple values, Var x, Var y, int32_t width, int32_t height, const std::string& name)
+{
+    Func sat(name);
+    sat(x, y) = values;
+
+    RDom h{1, width - 1, name + "_h"};
+    RDom v{1, height - 1, name + "_v"};
+    Tuple cur_h(sat(h, y)), left(sat(h - 1, y));
+    Tuple cur_v(sat(x, v)), up(sat(x, v - 1));
+    std::vector<Expr> row_sum, col_sum;
+    for (size_t i=0; i<values.size(); ++i) {
+        row_sum.push_back(cur_h[i] + left[i]);
+        col_sum.push_back(cur_v[i] + up[i]);
+    }
+    sat(h, y) = Tuple(row_sum);
+    sat(x, v) = Tuple(col_sum);
+
+    schedule(sat, {width, height});
+#if !defined(HALIDE_FOR_FPGA)
+    // Rows are scanned in parallel, and columns are scanned with vectors across x.
+    // Narrow frames or widths which are not a multiple of the strip are guarded, as in integral.
+    const int32_t vec = 4;
+    Var xo{"xo"}, xi{"xi"};
+    sat.parallel(y).vectorize(x, vec, TailStrategy::GuardWithIf);
+    sat.update(0).parallel(y);
+    sat.update(1).split(x, xo, xi, vec * 8, TailStrategy::GuardWithIf).reorder(xi, v, xo).parallel(xo)
+        .vectorize(xi, vec, TailStrategy::GuardWithIf);
+#endif
+
+    return sat;
+}
+
+// Narrowest unsigned integer type that holds a sum of count values up to max_value
+Type narrowest_accumulator_type(double max_value, double count)
+{
+    return max_value * count <= static_cast<double>(std::numeric_limits<uint32_t>::max()) ? UInt(32) : UInt(64);
+}
+
+// Integral image and squared integral image as a Tuple, built in a single traversal of the input.
+// Each is accumulated in the narrowest type that cannot overflow for width x height pixels of T.
+template<typename T>
+Func fused_integral(Func in, int32_t width, int32_t height)
+{
+    Var x{"x"}, y{"y"};
+
+    const double max_value = static_cast<double>(std::numeric_limits<T>::max());
+    const double count = static_cast<double>(width) * height;
+    Type sum_t = narrowest_accumulator_type(max_value, count);
+    Type sq_t = narrowest_accumulator_type(max_value * max_value, count);
+    throw_assert(max_value * max_value * count <= static_cast<double>(std::numeric_limits<uint64_t>::max()),
+                 "squared integral overflows uint64_t");
+
+    // The scanned table is returned as is, so that the tables are written once and not copied to another Func
+    Expr v = in(x, y);
+    return summed_area_table(Tuple(cast(sum_t, v), cast(sq_t, v) * cast(sq_t, v)), x, y, width, height, "integrals");
+}
+
+
+// On CPU, histograms are computed in parallel. Rows are split into strips of histogram_strip_rows,
+// each strip is binned into its own private sub-histogram, and the sub-histograms are merged
+// by a reduction vectorized across bins. For 8-bit images, consecutive pixels of a strip go to
+// histogram_lanes separate copies, so that the binning is vectorized without conflicting stores.
+const int32_t histogram_strip_rows = 64;
+const int32_t histogram_lanes = 8;
 
 template<typename T>
 Func histogram(Func src, int32_t width, int32_t height, int32_t hist_width)
@@ -313,13 +870,40 @@ Func histogram(Func src, int32_t width, int32_t height, int32_t hist_width)
     int32_t bin_size = (hist_size + hist_width - 1) / hist_width;
 
     Var x{"x"};
-    RDom r{0, width, 0, height};
 
     Func dst;
+#if defined(HALIDE_FOR_FPGA)
+    RDom r{0, width, 0, height};
+
     dst(x) = cast<uint32_t>(0);
 
     Expr idx = cast<int32_t>(src(r.x, r.y) / bin_size);
     dst(idx) += cast<uint32_t>(1);
+#else
+    const int32_t lanes = sizeof(T) == 1 && width % histogram_lanes == 0 ? histogram_lanes : 1;
+    const int32_t strips = (height + histogram_strip_rows - 1) / histogram_strip_rows;
+    Var lane{"lane"}, s{"s"};
+
+    RDom r{0, width / lanes, 0, histogram_strip_rows, "r"};
+    Expr row = s * histogram_strip_rows + r.y;
+    r.where(row < height);
+    row = min(row, height - 1);
+
+    Func partial{"partial"};
+    partial(x, lane, s) = cast<uint32_t>(0);
+    Expr idx = cast<int32_t>(src(r.x * lanes + lane, row) / bin_size);
+    partial(idx, lane, s) += cast<uint32_t>(1);
+
+    RDom m{0, lanes, 0, strips, "m"};
+    dst(x) = cast<uint32_t>(0);
+    dst(x) += partial(x, m.x, m.y);
+
+    schedule(partial, {hist_width, lanes, strips});
+    partial.vectorize(x, 8).parallel(s);
+    partial.update().vectorize(lane).parallel(s);
+    dst.vectorize(x, 8);
+    dst.update().vectorize(x, 8);
+#endif
 
     return dst;
 }
@@ -328,13 +912,40 @@ template<typename T>
 Func histogram2d(Func src0, Func src1, int32_t width, int32_t height, int32_t hist_width)
 {
     Var x{"x"}, y{"y"};
-    RDom r{0, width, 0, height};
 
     Func dst;
+#if defined(HALIDE_FOR_FPGA)
+    RDom r{0, width, 0, height};
+
     dst(x, y) = cast<uint32_t>(0);
     Expr idx0 = cast<int32_t>(src0(r.x, r.y) * cast<uint64_t>(hist_width) / (cast<uint64_t>(type_of<T>().max()) + 1));
     Expr idx1 = cast<int32_t>(src1(r.x, r.y) * cast<uint64_t>(hist_width) / (cast<uint64_t>(type_of<T>().max()) + 1));
     dst(idx0, idx1) += cast<uint32_t>(1);
+#else
+    const int32_t strips = (height + histogram_strip_rows - 1) / histogram_strip_rows;
+    Var s{"s"};
+
+    RDom r{0, width, 0, histogram_strip_rows, "r"};
+    Expr row = s * histogram_strip_rows + r.y;
+    r.where(row < height);
+    row = min(row, height - 1);
+
+    Func partial{"partial"};
+    partial(x, y, s) = cast<uint32_t>(0);
+    Expr idx0 = cast<int32_t>(src0(r.x, row) * cast<uint64_t>(hist_width) / (cast<uint64_t>(type_of<T>().max()) + 1));
+    Expr idx1 = cast<int32_t>(src1(r.x, row) * cast<uint64_t>(hist_width) / (cast<uint64_t>(type_of<T>().max()) + 1));
+    partial(idx0, idx1, s) += cast<uint32_t>(1);
+
+    RDom m{0, strips, "m"};
+    dst(x, y) = cast<uint32_t>(0);
+    dst(x, y) += partial(x, y, m);
+
+    schedule(partial, {hist_width, hist_width, strips});
+    partial.vectorize(x, 8).parallel(s);
+    partial.update().parallel(s);
+    dst.vectorize(x, 8);
+    dst.update().vectorize(x, 8);
+#endif
 
     return dst;
 }
@@ -361,11 +972,19 @@ Func sq_integral(Func src, int32_t width, int32_t height){
     Func dst{"dst"};
     dst(x, y) = cast<T>(src(x, y)) * cast<T>(src(x, y));
 
-    RDom h{1, width-1, 0, height, "h"};
-    dst(h.x, h.y) += dst(h.x-1, h.y);
-
-    RDom v{0, width, 1, height-1, "v"};
-    dst(v.x, v.y) += dst(v.x, v.y-1);
+    // Additions are in the same order as a sequential scan, so that floating point results do not change.
+    // Rows are scanned in parallel, and columns are scanned vectorized across x.
+    RDom h{1, width-1, "h"};
+    dst(h, y) += dst(h-1, y);
+
+    RDom v{1, height-1, "v"};
+    dst(x, v) += dst(x, v-1);
+#if !defined(HALIDE_FOR_FPGA)
+    Var xo{"xo"}, xi{"xi"};
+    dst.update(0).parallel(y);
+    dst.update(1).split(x, xo, xi, 64, TailStrategy::GuardWithIf).reorder(xi, v, xo).parallel(xo)
+        .vectorize(xi, 8, TailStrategy::GuardWithIf);
+#endif
     return dst;
 }
 
@@ -385,6 +1004,15 @@ Func average_value(Func src, Func roi, int32_t width, int32_t height)
 {
     Var x{"x"};
     Func count{"count"}, dst{"dst"};
+
+#if !defined(HALIDE_FOR_FPGA)
+    // Integer pixels are summed exactly in 64-bit integers and reduced in parallel.
+    // Floating-point pixels stay sequential to keep the order of additions.
+    if (!src.output_types()[0].is_float()) {
+        return roi_value<T>(roi_box_reduce(src, roi, width, height, 0, 0, width, height, ReductionOp::Sum, "total"), ReductionOp::Sum);
+    }
+#endif
+
     RDom r{0, width, 0, height, "r"};
     r.where(roi(r.x, r.y) != 0);
 
@@ -394,6 +1022,46 @@ Func average_value(Func src, Func roi, int32_t width, int32_t height)
         return dst;
 }
 
+// ROI-sparse versions of min_value, max_value and average_value.
+// The *_box versions visit only the box [x0, x0 + w) x [y0, y0 + h) clipped to the frame, in which roi selects the pixels.
+// The *_spans versions visit only the run-length encoded spans described in roi_spans_reduce.
+
+template<typename T>
+Func min_value_box(Func src, Func roi, int32_t width, int32_t height, Expr x0, Expr y0, Expr w, Expr h)
+{
+    return roi_value<T>(roi_box_reduce(src, roi, width, height, x0, y0, w, h, ReductionOp::Min, "res"), ReductionOp::Min);
+}
+
+template<typename T>
+Func max_value_box(Func src, Func roi, int32_t width, int32_t height, Expr x0, Expr y0, Expr w, Expr h)
+{
+    return roi_value<T>(roi_box_reduce(src, roi, width, height, x0, y0, w, h, ReductionOp::Max, "res"), ReductionOp::Max);
+}
+
+template<typename T>
+Func average_value_box(Func src, Func roi, int32_t width, int32_t height, Expr x0, Expr y0, Expr w, Expr h)
+{
+    return roi_value<T>(roi_box_reduce(src, roi, width, height, x0, y0, w, h, ReductionOp::Sum, "total"), ReductionOp::Sum);
+}
+
+template<typename T>
+Func min_value_spans(Func src, int32_t width, int32_t height, Func spans, Expr num_spans, int32_t max_span_width)
+{
+    return roi_value<T>(roi_spans_reduce(src, width, height, spans, num_spans, max_span_width, ReductionOp::Min, "res"), ReductionOp::Min);
+}
+
+template<typename T>
+Func max_value_spans(Func src, int32_t width, int32_t height, Func spans, Expr num_spans, int32_t max_span_width)
+{
+    return roi_value<T>(roi_spans_reduce(src, width, height, spans, num_spans, max_span_width, ReductionOp::Max, "res"), ReductionOp::Max);
+}
+
+template<typename T>
+Func average_value_spans(Func src, int32_t width, int32_t height, Func spans, Expr num_spans, int32_t max_span_width)
+{
+    return roi_value<T>(roi_spans_reduce(src, width, height, spans, num_spans, max_span_width, ReductionOp::Sum, "total"), ReductionOp::Sum);
+}
+
 Func filter_or(Func src0, Func src1) {
     Var x{"x"}, y{"y"};
     Func dst;
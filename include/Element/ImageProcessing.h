@@ -6,7 +6,10 @@
 
 #include <cassert>
 #include <cmath>
+#include <map>
+#include <string>
 #include <Halide.h>
+#include "Arithmetic.h"
 #include "FixedPoint.h"
 #include "Schedule.h"
 
@@ -109,9 +112,209 @@ Func affine(Func in, int32_t width, int32_t height, Param<float> degrees,
     return affine;
 }
 
+enum class GaussianAlgorithm {
+    Direct,    // 2D window in double precision
+    Separable, // Horizontal and vertical 1D windows in float
+    Recursive, // Young-van Vliet IIR, independent of sigma and the window size
+    Fixed      // 2D window with integer weights normalized by a shift
+};
+
+const std::map<std::string, GaussianAlgorithm> gaussian_algorithm_enum_map = {
+    {"direct",    GaussianAlgorithm::Direct},
+    {"separable", GaussianAlgorithm::Separable},
+    {"recursive", GaussianAlgorithm::Recursive},
+    {"fixed",     GaussianAlgorithm::Fixed}
+};
+
+// 1D Gaussian kernel on [-size/2, size - size/2), normalized to 1
+Func gaussian_kernel_1d(int32_t size, Param<double> sigma, const std::string& name)
+{
+    Var i{"i"};
+    RDom r(-(size / 2), size);
+
+    Func weight(name + "_weight");
+    weight(i) = cast<float>(exp(-(i * i) / (2 * sigma * sigma)));
+
+    Func weight_sum(name + "_sum");
+    weight_sum(i) = sum(weight(r));
+    schedule(weight_sum, {1});
+
+    Func kernel(name);
+    kernel(i) = weight(i) / weight_sum(0);
+    schedule(kernel, {-(size / 2)}, {size});
+
+    return kernel;
+}
+
+// The 2D kernel of gaussian() is the product of 1D kernels, so it is applied as a row pass and a column pass.
+// When stages is given, the row pass is left unscheduled and appended to it, so that the caller computes it
+// per strip or tile of dst with schedule_cpu_at().
+template<typename T>
+Func gaussian_separable(Func in, Expr width, Expr height, int32_t window_width, int32_t window_height, Param<double> sigma,
+                        std::vector<Func> *stages = nullptr, const Target& target = get_host_target())
+{
+    Var x{"x"}, y{"y"};
+
+    Func clamped = BoundaryConditions::repeat_edge(in, 0, width, 0, height);
+    Func kernel_x = gaussian_kernel_1d(window_width, sigma, "kernel_x");
+    Func kernel_y = gaussian_kernel_1d(window_height, sigma, "kernel_y");
+    RDom rx(-(window_width / 2), window_width);
+    RDom ry(-(window_height / 2), window_height);
+
+    Func rows("rows");
+    rows(x, y) = sum(cast<float>(clamped(x + rx, y)) * kernel_x(rx));
+
+    Func dst("dst");
+    dst(x, y) = cast<T>(round(sum(rows(x, y + ry) * kernel_y(ry))));
+
+    if (stages) {
+        stages->push_back(rows);
+        return dst;
+    }
+
+    rows.compute_root();
+#if !defined(HALIDE_FOR_FPGA)
+    rows.parallel(y).vectorize(x, target.natural_vector_size(rows.output_types()[0]));
+#endif
+
+    return dst;
+}
+
+// One direction of Young-van Vliet filter: causal then anti-causal 3rd order recursion along dim.
+// The line is extended by pad pixels at both ends so that transients from the initial state decay.
+Func gaussian_recursive_pass(Func in, int32_t dim, Expr extent, Expr pad, Expr b, Expr a1, Expr a2, Expr a3,
+                             const std::string& name, const Target& target = get_host_target())
+{
+    Var x{"x"}, y{"y"};
+    Var q = dim == 0 ? y : x;
+    auto at = [dim](Expr p, Expr q) { return dim == 0 ? std::vector<Expr>{p, q} : std::vector<Expr>{q, p}; };
+
+    Func causal(name + "_causal");
+    causal(x, y) = in(x, y);
+    RDom rc(-pad, extent + 2 * pad, name + "_rc");
+    causal(at(rc, q)) = b * in(at(rc, q)) + a1 * causal(at(rc - 1, q)) + a2 * causal(at(rc - 2, q)) + a3 * causal(at(rc - 3, q));
+
+    Func anti(name);
+    Var p = dim == 0 ? x : y;
+    anti(x, y) = causal(at(min(p, extent + pad - 1), q));
+    RDom ra(-pad, extent + 2 * pad, name + "_ra");
+    Expr n = extent - 1 - ra;
+    anti(at(n, q)) = b * causal(at(n, q)) + a1 * anti(at(n + 1, q)) + a2 * anti(at(n + 2, q)) + a3 * anti(at(n + 3, q));
+
+    causal.compute_root();
+    anti.compute_root();
+#if !defined(HALIDE_FOR_FPGA)
+    const int32_t vec = target.natural_vector_size(in.output_types()[0]);
+    auto schedule_scan = [&](Func f, RVar r) {
+        f.parallel(y).vectorize(x, vec);
+        if (dim == 0) {
+            // Scan along x, rows in parallel
+            f.update().parallel(y);
+        } else {
+            // Scan along y, vectorized across columns
+            Var xo{"xo"}, xi{"xi"};
+            f.update().split(x, xo, xi, vec * 4).reorder(xi, r, xo).parallel(xo).vectorize(xi, vec);
+        }
+    };
+    schedule_scan(causal, rc.x);
+    schedule_scan(anti, ra.x);
+#endif
+
+    return anti;
+}
+
+// Recursive Gaussian by Young and van Vliet, whose cost per pixel does not depend on sigma.
+// It approximates the untruncated kernel, so window_width and window_height are not used. sigma should be >= 0.5.
+template<typename T>
+Func gaussian_recursive(Func in, Expr width, Expr height, Param<double> sigma, const Target& target = get_host_target())
+{
+    Var x{"x"}, y{"y"};
+
+    Func clamped = BoundaryConditions::repeat_edge(in, 0, width, 0, height);
+    Func src("src_f32");
+    src(x, y) = cast<float>(clamped(x, y));
+
+    Expr s = cast<float>(sigma);
+    Expr q = select(s >= 2.5f, 0.98711f * s - 0.96330f, 3.97156f - 4.14554f * sqrt(1.0f - 0.26891f * s));
+    Expr q2 = q * q, q3 = q2 * q;
+    Expr b0 = 1.57825f + 2.44413f * q + 1.4281f * q2 + 0.422205f * q3;
+    Expr a1 = (2.44413f * q + 2.85619f * q2 + 1.26661f * q3) / b0;
+    Expr a2 = -(1.4281f * q2 + 1.26661f * q3) / b0;
+    Expr a3 = 0.422205f * q3 / b0;
+    Expr b = 1.0f - (a1 + a2 + a3);
+    Expr pad = cast<int32_t>(ceil(4.0f * s));
+
+    Func rows = gaussian_recursive_pass(src, 0, width, pad, b, a1, a2, a3, "rows", target);
+    Func rows_clamped = BoundaryConditions::repeat_edge(rows, 0, width, 0, height);
+    Func cols = gaussian_recursive_pass(rows_clamped, 1, height, pad, b, a1, a2, a3, "cols", target);
+
+    Func dst("dst");
+    dst(x, y) = cast<T>(clamp(round(cols(x, y)), cast<float>(type_of<T>().min()), cast<float>(type_of<T>().max())));
+
+    return dst;
+}
+
+// The 2D kernel is quantized once to unsigned FixedN weights whose sum is exactly 1 << FB,
+// so normalization is a rounding shift and the window is a sum of widening multiply-adds.
+// 8-bit images use 16-bit weights and 32-bit accumulators. 16-bit images use 32-bit weights and
+// 64-bit accumulators, since 15 fractional bits are not enough to stay within +-1 over the full range.
+template<typename T>
+Func gaussian_fixed(Func in, Expr width, Expr height, int32_t window_width, int32_t window_height, Param<double> sigma)
+{
+    constexpr uint32_t NB = sizeof(T) == 1 ? 16 : 32;
+    constexpr uint32_t FB = NB - 2;
+    const Type weight_type = UInt(NB);
+    const Type acc_type = UInt(NB * 2);
+
+    Var x{"x"}, y{"y"};
+
+    Func clamped = BoundaryConditions::repeat_edge(in, 0, width, 0, height);
+    RDom r(-(window_width / 2), window_width, -(window_height / 2), window_height);
+
+    Func kernel_f("kernel_f");
+    kernel_f(x, y) = exp(-(x * x + y * y) / (2 * sigma * sigma));
+
+    Func kernel_sum("kernel_sum");
+    kernel_sum(x) = sum(kernel_f(r.x, r.y));
+    schedule(kernel_sum, {1});
+
+    // to_fixed truncates, so half an ulp is added to round to nearest
+    Func quantized("quantized");
+    quantized(x, y) = fixed_expr<NB, FB, false>(kernel_f(x, y) / kernel_sum(0) + 0.5 / (1 << FB));
+
+    Func quantized_sum("quantized_sum");
+    quantized_sum(x) = sum(cast(acc_type, quantized(r.x, r.y)));
+    schedule(quantized_sum, {1});
+
+    // The rounding residual goes to the center tap, which is the largest weight
+    Func kernel("kernel");
+    Expr residual = cast(acc_type, 1 << FB) - quantized_sum(0);
+    kernel(x, y) = select(x == 0 && y == 0, cast(weight_type, cast(acc_type, quantized(x, y)) + residual), quantized(x, y));
+    schedule(kernel, {-(window_width / 2), -(window_height / 2)}, {window_width, window_height});
+
+    Expr acc = sum(cast(acc_type, clamped(x + r.x, y + r.y)) * cast(acc_type, kernel(r.x, r.y)));
+
+    Func dst("dst");
+    dst(x, y) = cast<T>((acc + cast(acc_type, 1 << (FB - 1))) >> FB);
+
+    return dst;
+}
+
 template<typename T>
-Func gaussian(Func in, int32_t width, int32_t height, int32_t window_width, int32_t window_height, Param<double> sigma)
+Func gaussian(Func in, Expr width, Expr height, int32_t window_width, int32_t window_height, Param<double> sigma,
+              GaussianAlgorithm algorithm = GaussianAlgorithm::Direct, std::vector<Func> *stages = nullptr,
+              const Target& target = get_host_target())
 {
+    if (algorithm == GaussianAlgorithm::Separable) {
+        return gaussian_separable<T>(in, width, height, window_width, window_height, sigma, stages, target);
+    }
+    if (algorithm == GaussianAlgorithm::Recursive) {
+        return gaussian_recursive<T>(in, width, height, sigma, target);
+    }
+    if (algorithm == GaussianAlgorithm::Fixed) {
+        return gaussian_fixed<T>(in, width, height, window_width, window_height, sigma);
+    }
+
     Var x{"x"}, y{"y"};
 
     Func clamped = BoundaryConditions::repeat_edge(in, 0, width, 0, height);
@@ -135,35 +338,171 @@ Func gaussian(Func in, int32_t width, int32_t height, int32_t window_width, int3
     return dst;
 }
 
+// Window sizes of convolution(): max_kernel_size, and the odd sizes below it.
+std::vector<int32_t> convolution_window_sizes(int32_t max_kernel_size)
+{
+    std::vector<int32_t> sizes;
+    for (int32_t s = 1; s < max_kernel_size; s += 2) {
+        sizes.push_back(s);
+    }
+    sizes.push_back(max_kernel_size);
+    return sizes;
+}
+
+// kernel_size is given at runtime and clamped to [1, max_kernel_size]. There is a fully unrolled window
+// for each of convolution_window_sizes(), which covers the kernel sizes up to its own with the taps beyond
+// kernel_size being 0. The smallest window which fits kernel_size is selected; call specialize_convolution()
+// on the scheduled output, so that only that window is computed.
 template<uint32_t NB, uint32_t FB>
-Func convolution(Func in, int32_t width, int32_t height, Func kernel, int32_t kernel_size, int32_t unroll_factor) {
+Func convolution(Func in, int32_t width, int32_t height, Func kernel, Expr kernel_size, int32_t max_kernel_size, int32_t unroll_factor) {
     Var x, y;
 
     Func bounded = BoundaryConditions::repeat_edge(in, 0, width, 0, height);
 
-    Expr kh = Halide::div_round_to_zero(kernel_size, 2);
-    RDom r(0, kernel_size, 0, kernel_size);
-
-    Expr dx = r.x - kh;
-    Expr dy = r.y - kh;
+    Expr size = clamp(kernel_size, 1, max_kernel_size);
+    Expr kh = Halide::div_round_to_zero(size, 2);
 
     Func k;
-    k(x, y) = kernel(x, y);
+    k(x, y) = select(x < size && y < size, kernel(x, y), 0);
+
+    using FixedNB = FixedN<NB, FB>;
+    const std::vector<int32_t> sizes = convolution_window_sizes(max_kernel_size);
+    Expr value;
+    for (auto it = sizes.rbegin(); it != sizes.rend(); ++it) {
+        RDom r(0, *it, 0, *it);
+        FixedNB pv = to_fixed<NB, FB>(bounded(x + r.x - kh, y + r.y - kh));
+        FixedNB kv{k(r.x, r.y)};
+        Expr window = static_cast<Expr>(sum_unroll(r, pv * kv));
+        value = value.defined() ? select(kernel_size <= *it, window, value) : window;
+    }
+
+    Func out("out");
+    out(x, y) = from_fixed<uint8_t>(FixedNB{value});
+
+    schedule(k, {max_kernel_size, max_kernel_size});
+
+    return out;
+}
+
+// Specializes out of convolution() for each window size, after out is scheduled.
+Func& specialize_convolution(Func& out, Expr kernel_size, int32_t max_kernel_size)
+{
+#if !defined(HALIDE_FOR_FPGA)
+    const std::vector<int32_t> sizes = convolution_window_sizes(max_kernel_size);
+    for (size_t i = 0; i + 1 < sizes.size(); ++i) {
+        out.specialize(kernel_size <= sizes[i]);
+    }
+#endif
+    return out;
+}
+
+// Convolution with a separable kernel kernel_x(i) * kernel_y(j), executed as a row pass and a column pass,
+// so the cost per pixel is 2 * kernel_size multiply-adds instead of kernel_size^2.
+// Each pass accumulates the products in the upper type and is normalized once.
+template<uint32_t NB, uint32_t FB>
+Func convolution_separable(Func in, int32_t width, int32_t height, Func kernel_x, Func kernel_y, int32_t kernel_size) {
+    Var x, y, i;
+
+    Func bounded = BoundaryConditions::repeat_edge(in, 0, width, 0, height);
+
+    Expr kh = Halide::div_round_to_zero(kernel_size, 2);
+    RDom r(0, kernel_size);
+
+    Func kx, ky;
+    kx(i) = kernel_x(i);
+    ky(i) = kernel_y(i);
 
     using FixedNB = FixedN<NB, FB>;
-    FixedNB pv = to_fixed<NB, FB>(bounded(x+dx, y+dy));
-    FixedNB kv{k(r.x, r.y)};
+
+    Func rows("rows");
+    rows(x, y) = static_cast<Expr>(mac_unroll(r, to_fixed<NB, FB>(bounded(x + r.x - kh, y)), FixedNB{kx(r.x)}));
 
     Func out("out");
-    out(x, y) = from_fixed<uint8_t>(sum_unroll(r, pv * kv));
+    out(x, y) = from_fixed<uint8_t>(mac_unroll(r, FixedNB{rows(x, y + r.x - kh)}, FixedNB{ky(r.x)}));
 
-    schedule(kernel, {5, 5});
-    schedule(k, {5, 5});
+    schedule(kx, {kernel_size});
+    schedule(ky, {kernel_size});
+    schedule(rows, {0, -kh}, {width, height + kernel_size - 1});
+#if !defined(HALIDE_FOR_FPGA)
+    rows.parallel(y).vectorize(x, 8);
+#endif
 
     return out;
 }
 
 
+// B^T of Winograd F(2, 3) along one axis
+Expr winograd_bt(Expr k, Expr d0, Expr d1, Expr d2, Expr d3)
+{
+    return select(k == 0, d0 - d2, select(k == 1, d1 + d2, select(k == 2, d2 - d1, d1 - d3)));
+}
+
+// 2G of Winograd F(2, 3) along one axis. G has halves, so it is doubled to keep the kernel integer.
+Expr winograd_g2(Expr k, Expr g0, Expr g1, Expr g2)
+{
+    return select(k == 0, 2 * g0, select(k == 1, g0 + g1 + g2, select(k == 2, g0 - g1 + g2, 2 * g2)));
+}
+
+// A^T of Winograd F(2, 3) along one axis
+Expr winograd_at(Expr k, Expr m0, Expr m1, Expr m2, Expr m3)
+{
+    return select(k == 0, m0 + m1 + m2, m1 - m2 - m3);
+}
+
+// Convolution with a 3x3 kernel by Winograd F(2x2, 3x3), which takes 16 multiplies per 2x2 output block instead of 36.
+// The kernel is transformed once to 4 * G g G^T, and each block is A^T (U * B^T d B) A over a 4x4 input tile d.
+// The factor 4 is removed by the final shift, so the result is exactly (sum of in * kernel) >> FB.
+// Transforms are accumulated in int32_t, so |kernel| should be below 2^14.
+// On CPU the loop nest of out is set here, so the caller should not apply schedule_cpu() to it.
+template<uint32_t FB>
+Func convolution_winograd(Func in, int32_t width, int32_t height, Func kernel) {
+    Var x{"x"}, y{"y"}, i{"i"}, j{"j"}, bx{"bx"}, by{"by"};
+
+    Func bounded = BoundaryConditions::repeat_edge(in, 0, width, 0, height);
+
+    Func kernel_x("kernel_x"), transformed_kernel("transformed_kernel");
+    kernel_x(i, j) = winograd_g2(i, kernel(0, j), kernel(1, j), kernel(2, j));
+    transformed_kernel(i, j) = winograd_g2(j, kernel_x(i, 0), kernel_x(i, 1), kernel_x(i, 2));
+
+    Func tile("tile");
+    tile(i, j, bx, by) = cast<int32_t>(bounded(bx * 2 + i - 1, by * 2 + j - 1));
+
+    Func tile_x("tile_x"), transformed_tile("transformed_tile");
+    tile_x(i, j, bx, by) = winograd_bt(i, tile(0, j, bx, by), tile(1, j, bx, by), tile(2, j, bx, by), tile(3, j, bx, by));
+    transformed_tile(i, j, bx, by) = winograd_bt(j, tile_x(i, 0, bx, by), tile_x(i, 1, bx, by),
+                                                 tile_x(i, 2, bx, by), tile_x(i, 3, bx, by));
+
+    Func product("product");
+    product(i, j, bx, by) = transformed_kernel(i, j) * transformed_tile(i, j, bx, by);
+
+    Func block_x("block_x"), block("block");
+    block_x(i, j, bx, by) = winograd_at(i, product(0, j, bx, by), product(1, j, bx, by),
+                                        product(2, j, bx, by), product(3, j, bx, by));
+    block(i, j, bx, by) = winograd_at(j, block_x(i, 0, bx, by), block_x(i, 1, bx, by),
+                                      block_x(i, 2, bx, by), block_x(i, 3, bx, by));
+
+    Func out("out");
+    out(x, y) = cast<uint8_t>(block(x % 2, y % 2, x / 2, y / 2) >> (FB + 2));
+
+    schedule(transformed_kernel, {4, 4});
+#if defined(HALIDE_FOR_FPGA)
+    schedule(block, {2, 2, (width + 1) / 2, (height + 1) / 2});
+#else
+    // A row of blocks is computed for each pair of output rows, so only one row of blocks is live per thread.
+    // Tiles of vec blocks are transformed in registers, with the 4x4 dimensions unrolled
+    const int32_t vec = 8;
+    Var yo{"yo"}, yi{"yi"}, bxo{"bxo"}, bxi{"bxi"};
+    out.split(y, yo, yi, 2).unroll(yi).vectorize(x, vec).parallel(yo);
+    block.compute_at(out, yo);
+    block.split(bx, bxo, bxi, vec).reorder(bxi, i, j, bxo, by).vectorize(bxi).unroll(i).unroll(j);
+    for (Func f : {transformed_tile, product, block_x}) {
+        f.compute_at(block, bxo).reorder(bx, i, j, by).vectorize(bx, vec).unroll(i).unroll(j);
+    }
+#endif
+
+    return out;
+}
+
 template<uint32_t frac_bits>
 Func gamma_correction(Func in, Expr value)
 {
@@ -410,7 +749,225 @@ Func bitonic_sort(Func input, int32_t size, int32_t width, int32_t height) {
     return next;
 }
 
-Func median(Func in, int32_t width, int32_t height, int32_t window_width, int32_t window_height) {
+enum class MedianAlgorithm {
+    Sort,      // Bitonic sort of the whole window
+    Histogram, // Sliding histograms, independent of the window size (uint8 only)
+    Network    // Selection networks on sorted columns (3x3 and 5x5 only)
+};
+
+const std::map<std::string, MedianAlgorithm> median_algorithm_enum_map = {
+    {"sort",      MedianAlgorithm::Sort},
+    {"histogram", MedianAlgorithm::Histogram},
+    {"network",   MedianAlgorithm::Network}
+};
+
+// Rows per strip of median_histogram(). Each strip has its own column counts.
+const int32_t median_strip_rows = 32;
+
+// Median filter by sliding histograms (Perreault and Hebert).
+// For each bin b, the number of pixels <= b in the window is counted by running sums along y and then x,
+// and the median is the number of bins whose count does not exceed half of the window.
+// Strips of rows are processed in parallel, and each bin of a strip fits in cache.
+Func median_histogram(Func in, int32_t width, int32_t height, int32_t window_width, int32_t window_height) {
+    const Type type = in.value().type();
+    throw_assert(type == UInt(8), "histogram median supports uint8 only.");
+
+    const int32_t offset_x = window_width / 2, offset_y = window_height / 2;
+    const int32_t half = window_width * window_height / 2;
+    const int32_t strip = median_strip_rows;
+    const int32_t bins = 256;
+
+    Func clamped = BoundaryConditions::repeat_edge(in, {{0, width}, {0, height}});
+
+    Var x{"x"}, y{"y"}, t{"t"}, s{"s"}, b{"b"};
+
+    // Pixels <= b in rows [s * strip - offset_y, s * strip - offset_y + t) of column x.
+    // Counts are 16 bit and may wrap around, but differences of them are exact.
+    Func column{"median_column"};
+    column(x, t, s, b) = cast<uint16_t>(0);
+    RDom rt{1, strip + window_height - 1, "rt"};
+    column(x, rt, s, b) = column(x, rt - 1, s, b) + cast<uint16_t>(clamped(x, s * strip - offset_y + rt - 1) <= b);
+
+    // Column windows of [-offset_x, t - offset_x) summed along row y
+    Func row{"median_row"};
+    row(t, y, b) = cast<uint16_t>(0);
+    RDom rx{1, width + window_width - 1, "rx"};
+    Expr cx = rx - 1 - offset_x;
+    row(rx, y, b) = row(rx - 1, y, b) + column(cx, y % strip + window_height, y / strip, b) - column(cx, y % strip, y / strip, b);
+
+    Func rank{"median_rank"};
+    rank(x, y) = cast<uint8_t>(0);
+    RDom rb{0, bins - 1, "rb"};
+    Expr count = row(x + window_width, y, rb) - row(x, y, rb);
+    rank(x, y) += cast<uint8_t>(count <= half);
+
+    Func median("median");
+    median(x, y) = rank(x, y);
+
+    Var yo{"yo"}, yi{"yi"};
+    rank.compute_root();
+    rank.update().split(y, yo, yi, strip).reorder(x, yi, rb, yo);
+    column.compute_at(rank, rb);
+    column.update().reorder(x, rt, s, b);
+    row.compute_at(rank, rb).reorder_storage(y, t, b);
+    row.update().reorder(y, rx, b);
+#if !defined(HALIDE_FOR_FPGA)
+    const int32_t vec = 16;
+    rank.vectorize(x, vec).parallel(y);
+    rank.update().parallel(yo).vectorize(x, vec);
+    column.vectorize(x, vec);
+    column.update().vectorize(x, vec);
+    row.update().vectorize(y, vec);
+#endif
+
+    return median;
+}
+
+// Compare and exchange of sorting networks
+void compare_exchange(Expr& a, Expr& b) {
+    Expr lo = min(a, b);
+    b = max(a, b);
+    a = lo;
+}
+
+Expr median3(Expr a, Expr b, Expr c) {
+    return max(min(a, b), min(max(a, b), c));
+}
+
+// Sorts 3 or 5 values in ascending order
+void sort_network(std::vector<Expr>& v) {
+    static const std::vector<std::pair<int, int>> network3 = {{0, 1}, {1, 2}, {0, 1}};
+    static const std::vector<std::pair<int, int>> network5 = {{0, 1}, {3, 4}, {2, 4}, {2, 3}, {1, 4},
+                                                              {0, 3}, {0, 2}, {1, 3}, {1, 2}};
+    throw_assert(v.size() == 3 || v.size() == 5, "sort_network supports 3 or 5 values.");
+    for (auto& p : v.size() == 3 ? network3 : network5) {
+        compare_exchange(v[p.first], v[p.second]);
+    }
+}
+
+// Removes the minimum and the maximum of v, leaving the others in arbitrary order
+std::vector<Expr> drop_min_max(std::vector<Expr> v) {
+    const size_t n = v.size();
+    for (size_t i = 1; i < n; i++) {
+        compare_exchange(v[0], v[i]);
+    }
+    for (size_t i = 1; i + 1 < n; i++) {
+        compare_exchange(v[i], v[n - 1]);
+    }
+    return std::vector<Expr>(v.begin() + 1, v.end() - 1);
+}
+
+// Median filter for 3x3 and 5x5 windows without sorting the whole window.
+// Each column of the window is sorted once per pixel and shared by the horizontal neighbors.
+// 3x3: median of (max of minimums, median of medians, min of maximums) of the sorted columns.
+// 5x5: after sorting ranks across the columns, 13 candidates are left,
+// and forgetful selection drops the minimum and the maximum until 3 values remain.
+Func median_network(Func in, int32_t width, int32_t height, int32_t window_width, int32_t window_height,
+                    const Target& target = get_host_target()) {
+    throw_assert(window_width == window_height && (window_width == 3 || window_width == 5),
+                 "network median supports 3x3 and 5x5 windows only.");
+
+    const int32_t n = window_width;
+    const int32_t offset = n / 2;
+
+    Func clamped = BoundaryConditions::repeat_edge(in, {{0, width}, {0, height}});
+
+    Var x{"x"}, y{"y"};
+
+    Func column{"median_column"};
+    std::vector<Expr> c;
+    for (int32_t j = -offset; j <= offset; j++) {
+        c.push_back(clamped(x, y + j));
+    }
+    sort_network(c);
+    column(x, y) = Tuple(c);
+
+    // Stages which are materialized per vector, to keep expressions small
+    std::vector<Func> stages;
+
+    Func med{"median_network"};
+    if (n == 3) {
+        Expr lo = max(max(column(x - 1, y)[0], column(x, y)[0]), column(x + 1, y)[0]);
+        Expr mid = median3(column(x - 1, y)[1], column(x, y)[1], column(x + 1, y)[1]);
+        Expr hi = min(min(column(x - 1, y)[2], column(x, y)[2]), column(x + 1, y)[2]);
+        med(x, y) = median3(lo, mid, hi);
+    } else {
+        // m[k][i]: k-th smallest of column x + i - offset, sorted along i
+        std::vector<std::vector<Expr>> m(n);
+        for (int32_t k = 0; k < n; k++) {
+            for (int32_t i = -offset; i <= offset; i++) {
+                m[k].push_back(column(x + i, y)[k]);
+            }
+            sort_network(m[k]);
+        }
+
+        // m[k][i] is not less than (k+1)*(i+1) values and not greater than (n-k)*(n-i) values.
+        const int32_t rank = n * n / 2 + 1;
+        std::vector<Expr> candidates;
+        for (int32_t k = 0; k < n; k++) {
+            for (int32_t i = 0; i < n; i++) {
+                if ((k + 1) * (i + 1) <= rank && (n - k) * (n - i) <= rank) {
+                    candidates.push_back(m[k][i]);
+                }
+            }
+        }
+
+        Func cand{"median_candidates"};
+        cand(x, y) = Tuple(candidates);
+        stages.push_back(cand);
+
+        // Forgetful selection: min and max of (remaining / 2 + 2) values can not be the median.
+        const int32_t total = static_cast<int32_t>(candidates.size());
+        int32_t next = total / 2 + 2;
+        std::vector<Expr> work;
+        for (int32_t i = 0; i < next; i++) {
+            work.push_back(cand(x, y)[i]);
+        }
+        while (next < total) {
+            work = drop_min_max(work);
+            work.push_back(cand(x, y)[next++]);
+
+            Func round{"median_forgetful" + std::to_string(next)};
+            round(x, y) = Tuple(work);
+            stages.push_back(round);
+            for (size_t i = 0; i < work.size(); i++) {
+                work[i] = round(x, y)[i];
+            }
+        }
+        med(x, y) = median3(work[0], work[1], work[2]);
+    }
+
+    Func median("median");
+    median(x, y) = med(x, y);
+
+    med.compute_root();
+    column.compute_at(med, y);
+#if !defined(HALIDE_FOR_FPGA)
+    const int32_t vec = target.natural_vector_size(in.value().type());
+    Var xo{"xo"}, xi{"xi"};
+    med.split(x, xo, xi, vec).vectorize(xi).parallel(y);
+    column.vectorize(x, vec);
+    for (auto& f : stages) {
+        f.compute_at(med, xo).vectorize(x, vec);
+    }
+#else
+    for (auto& f : stages) {
+        f.compute_at(med, x);
+    }
+#endif
+
+    return median;
+}
+
+Func median(Func in, int32_t width, int32_t height, int32_t window_width, int32_t window_height,
+            MedianAlgorithm algorithm = MedianAlgorithm::Sort, const Target& target = get_host_target()) {
+    if (algorithm == MedianAlgorithm::Histogram) {
+        return median_histogram(in, width, height, window_width, window_height);
+    }
+    if (algorithm == MedianAlgorithm::Network) {
+        return median_network(in, width, height, window_width, window_height, target);
+    }
+
     Expr offset_x = window_width / 2, offset_y = window_height / 2;
     int32_t window_size = window_width * window_height;
 
@@ -437,7 +994,7 @@ Func median(Func in, int32_t width, int32_t height, int32_t window_width, int32_
 }
 
 template<typename T>
-Func laplacian(Func in, int32_t width, int32_t height) {
+Func laplacian(Func in, Expr width, Expr height) {
     Var x{"x"}, y{"y"};
 
     Func clamped = BoundaryConditions::repeat_edge(in, {{0, width}, {0, height}});
@@ -460,7 +1017,7 @@ Func laplacian(Func in, int32_t width, int32_t height) {
 }
 
 template<typename T>
-Func prewitt(Func input, int32_t width, int32_t height)
+Func prewitt(Func input, Expr width, Expr height)
 {
     Var x, y;
     Func input_f("input_f");
@@ -484,7 +1041,7 @@ Func prewitt(Func input, int32_t width, int32_t height)
 }
 
 template<typename T>
-Func sobel(Func input, int32_t width, int32_t height)
+Func sobel(Func input, Expr width, Expr height)
 {
     Var x, y;
     Func input_f("input_f");
@@ -620,13 +1177,158 @@ Func sad(Func input0, Func input1, int32_t width, int32_t height)
 	return output;
 }
 
-template<typename T>Func bilateral(Func src, int32_t width, int32_t height, Expr wSize, Expr color, Expr space)
+enum class BilateralAlgorithm {
+    Direct, // wSize x wSize window
+    Grid,   // Bilateral grid, whose cost does not depend on the spatial radius
+    Lut     // wSize x wSize window with the range kernel read from an interpolated LUT (for uint16_t)
+};
+
+const std::map<std::string, BilateralAlgorithm> bilateral_algorithm_enum_map = {
+    {"direct", BilateralAlgorithm::Direct},
+    {"grid",   BilateralAlgorithm::Grid},
+    {"lut",    BilateralAlgorithm::Lut}
+};
+
+// Bilateral grid by Chen, Paris and Durand.
+// Pixels are splatted to a grid downsampled by space in x and y and by color in intensity,
+// the grid is blurred by [1 4 6 4 1] in each dimension, and the output is sliced by trilinear interpolation.
+// It approximates the Gaussian spatial kernel of sigma = space, so wSize is not used.
+template<typename T>
+Func bilateral_grid(Func src, int32_t width, int32_t height, Expr color, Expr space, const Target& target = get_host_target())
+{
+    Var x{"x"}, y{"y"}, z{"z"}, c{"c"};
+
+    Expr s = max(cast<int32_t>(round(space)), 1);
+    Expr r = cast<float>(color);
+    Expr depth = cast<int32_t>(cast<float>(type_of<T>().max()) / r) + 1;
+
+    Func clamped = BoundaryConditions::repeat_edge(src, 0, width, 0, height);
+
+    // Splat: a grid cell gathers the s x s tile of pixels around it,
+    // so cells are filled independently. c = 0 is the sum of intensity and c = 1 is the weight.
+    RDom t(0, s, 0, s, "t");
+    Expr val = cast<float>(clamped(x * s + t.x - s / 2, y * s + t.y - s / 2));
+    Expr zi = clamp(cast<int32_t>(val / r + 0.5f), 0, depth);
+    Func grid("grid");
+    grid(x, y, z, c) = 0.0f;
+    grid(x, y, zi, c) += select(c == 0, val, 1.0f);
+
+    Func blurz("blurz");
+    blurz(x, y, z, c) = grid(x, y, z - 2, c) + grid(x, y, z - 1, c) * 4 + grid(x, y, z, c) * 6
+                      + grid(x, y, z + 1, c) * 4 + grid(x, y, z + 2, c);
+    Func blurx("blurx");
+    blurx(x, y, z, c) = blurz(x - 2, y, z, c) + blurz(x - 1, y, z, c) * 4 + blurz(x, y, z, c) * 6
+                      + blurz(x + 1, y, z, c) * 4 + blurz(x + 2, y, z, c);
+    Func blury("blury");
+    blury(x, y, z, c) = blurx(x, y - 2, z, c) + blurx(x, y - 1, z, c) * 4 + blurx(x, y, z, c) * 6
+                      + blurx(x, y + 1, z, c) * 4 + blurx(x, y + 2, z, c);
+
+    // Slice
+    Expr zv = cast<float>(clamped(x, y)) / r;
+    Expr zs = clamp(cast<int32_t>(zv), 0, depth - 1);
+    Expr zf = zv - zs;
+    Expr xs = x / s, ys = y / s;
+    Expr xf = cast<float>(x % s) / s;
+    Expr yf = cast<float>(y % s) / s;
+    auto bilinear = [&](Expr zz) {
+        return lerp(lerp(blury(xs, ys, zz, c), blury(xs + 1, ys, zz, c), xf),
+                    lerp(blury(xs, ys + 1, zz, c), blury(xs + 1, ys + 1, zz, c), xf), yf);
+    };
+    Func interpolated("interpolated");
+    interpolated(x, y, c) = lerp(bilinear(zs), bilinear(zs + 1), zf);
+
+    Func dst("dst");
+    Expr num = round(interpolated(x, y, 0) / interpolated(x, y, 1));
+    dst(x, y) = cast<T>(clamp(num, 0.0f, cast<float>(type_of<T>().max())));
+
+    grid.compute_root();
+    blurz.compute_root();
+    blurx.compute_root();
+    blury.compute_root();
+#if !defined(HALIDE_FOR_FPGA)
+    grid.parallel(z);
+    grid.update().reorder(c, t.x, t.y, x, y).unroll(c).parallel(y);
+    const int32_t vec = target.natural_vector_size(Float(32));
+    blurz.reorder(c, z, x, y).unroll(c).vectorize(x, vec).parallel(y);
+    blurx.reorder(c, z, x, y).unroll(c).vectorize(x, vec).parallel(y);
+    blury.reorder(c, z, x, y).unroll(c).vectorize(x, vec).parallel(y);
+#endif
+
+    return dst;
+}
+
+const int32_t bilateral_lut_size = 4096;
+
+// The range kernel of uint16_t is quantized to bilateral_lut_size steps over |diff| in [0, min(8 * color, 65535)]
+// and read with linear interpolation. Weights beyond 8 sigma are below float resolution and are 0.
+// The weight of a tap is computed once and accumulated to both numerator and denominator.
+Func bilateral_lut(Func src, int32_t width, int32_t height, Expr wSize, Expr color, Expr space,
+                   const Target& target = get_host_target())
+{
+    Var x{"x"}, y{"y"}, i{"i"};
+
+    Expr step = cast<float>(min(8 * color, cast<double>(type_of<uint16_t>().max()))) / bilateral_lut_size;
+    Func kernel_r{"kernel_r"};
+    Expr dr = cast<double>(i) * step;
+    kernel_r(i) = cast<float>(exp(-0.5 * dr * dr / (color * color)));
+    schedule(kernel_r, {bilateral_lut_size + 1});
+
+    Expr wRadius = cast<int>(wSize/2);
+    RDom w{0, wSize, 0, wSize, "w"};
+
+    Expr diff_x = cast<double>(x-wRadius);
+    Expr diff_y = cast<double>(y-wRadius);
+    Expr r = sqrt(diff_y*diff_y + diff_x*diff_x);
+    Func kernel_d{"kernel_d"};
+    kernel_d(x, y) = cast<float>(select(r > wRadius, 0,
+                                        exp(-0.5f * (diff_x * diff_x + diff_y * diff_y) / (space * space))));
+    schedule(kernel_d, {wSize, wSize});
+
+    Func clamped = BoundaryConditions::repeat_edge(src, 0, width, 0, height);
+    Func bri;
+    bri(x, y) = clamped(x-wRadius, y-wRadius);
+
+    Expr b = bri(x+w.x, y+w.y);
+    Expr fd = cast<float>(absd(src(x, y), b)) / step;
+    // fd may be huge, or NaN when color is 0, so the LUT index is clamped at both ends
+    Expr index = clamp(cast<int32_t>(min(fd, float(bilateral_lut_size))), 0, bilateral_lut_size - 1);
+    Expr weight_r = select(fd > bilateral_lut_size, 0.0f,
+                           lerp(kernel_r(index), kernel_r(index + 1), clamp(fd - index, 0.0f, 1.0f)));
+    Expr weight = kernel_d(w.x, w.y) * weight_r;
+
+    Func weighted{"weighted"};
+    weighted(x, y) = Tuple(0.0f, 0.0f);
+    weighted(x, y) = Tuple(weighted(x, y)[0] + weight * cast<float>(b), weighted(x, y)[1] + weight);
+
+    Func dst{"dst"};
+    dst(x, y) = cast<uint16_t>(round(weighted(x, y)[0] / weighted(x, y)[1]));
+
+    // Both sums are accumulated once per pixel, as num of the direct path is
+    schedule(weighted, {width, height});
+#if !defined(HALIDE_FOR_FPGA)
+    const int32_t vec = target.natural_vector_size(Float(32));
+    weighted.parallel(y).vectorize(x, vec);
+    weighted.update().parallel(y).vectorize(x, vec);
+#endif
+
+    return dst;
+}
+
+template<typename T>Func bilateral(Func src, int32_t width, int32_t height, Expr wSize, Expr color, Expr space,
+                                   BilateralAlgorithm algorithm = BilateralAlgorithm::Direct,
+                                   const Target& target = get_host_target())
 {
     return Func();
 }
 //for uint8_t and for uint16_t
 
-template<> Func bilateral<uint8_t>(Func src, int32_t width, int32_t height, Expr wSize, Expr color, Expr space){
+template<> Func bilateral<uint8_t>(Func src, int32_t width, int32_t height, Expr wSize, Expr color, Expr space,
+                                   BilateralAlgorithm algorithm, const Target& target){
+    if (algorithm == BilateralAlgorithm::Grid) {
+        return bilateral_grid<uint8_t>(src, width, height, color, space, target);
+    }
+    // uint8_t always reads the range kernel from a LUT over all differences, so Lut is the same as Direct.
+
     Func dst{"dst"};
     Var x{"x"}, y{"y"};
 
@@ -672,7 +1374,15 @@ template<> Func bilateral<uint8_t>(Func src, int32_t width, int32_t height, Expr
     return dst;
 }
 
-template<> Func bilateral<uint16_t>(Func src, int32_t width, int32_t height, Expr wSize, Expr color, Expr space){
+template<> Func bilateral<uint16_t>(Func src, int32_t width, int32_t height, Expr wSize, Expr color, Expr space,
+                                    BilateralAlgorithm algorithm, const Target& target){
+    if (algorithm == BilateralAlgorithm::Grid) {
+        return bilateral_grid<uint16_t>(src, width, height, color, space, target);
+    }
+    if (algorithm == BilateralAlgorithm::Lut) {
+        return bilateral_lut(src, width, height, wSize, color, space, target);
+    }
+
     Func dst{"dst"};
     Var x{"x"}, y{"y"};
 
@@ -713,6 +1423,161 @@ template<> Func bilateral<uint16_t>(Func src, int32_t width, int32_t height, Exp
     return dst;
 }
 
+// Sum of the i-th value of sat over the (2 * radius + 1)^2 window clipped to the image
+Expr box_sum(Func sat, int32_t i, Expr x, Expr y, int32_t width, int32_t height, int32_t radius)
+{
+    auto at = [&](Expr px, Expr py) {
+        Expr v = Tuple(sat(max(px, 0), max(py, 0)))[i];
+        return select(px < 0 || py < 0, cast(v.type(), 0), v);
+    };
+    Expr x0 = max(x - radius - 1, -1), x1 = min(x + radius, width - 1);
+    Expr y0 = max(y - radius - 1, -1), y1 = min(y + radius, height - 1);
+    return at(x1, y1) - at(x0, y1) - at(x1, y0) + at(x0, y0);
+}
+
+// Number of pixels in the window of box_sum()
+Expr box_count(Expr x, Expr y, int32_t width, int32_t height, int32_t radius)
+{
+    Expr w = min(x + radius, width - 1) - max(x - radius, 0) + 1;
+    Expr h = min(y + radius, height - 1) - max(y - radius, 0) + 1;
+    return cast<double>(w * h);
+}
+
+// Guided filter by He, Sun and Tang, guided by the input itself for edge-preserving smoothing.
+// The four box means (I, I^2, a and b) are read from two summed area tables in O(1) per pixel,
+// so the cost does not depend on radius. Each table holds two values and is built in one pass,
+// and a and b are computed inline while their table is built.
+template<typename T>
+Func guided_filter(Func src, int32_t width, int32_t height, int32_t radius, Expr eps)
+{
+    Var x{"x"}, y{"y"};
+
+    Expr i = cast<uint64_t>(src(x, y));
+    Func sum_i = summed_area_table(Tuple(i, i * i), x, y, width, height, "sum_i");
+
+    Expr n = box_count(x, y, width, height, radius);
+    Expr mean_i = cast<double>(box_sum(sum_i, 0, x, y, width, height, radius)) / n;
+    Expr mean_ii = cast<double>(box_sum(sum_i, 1, x, y, width, height, radius)) / n;
+    Expr var_i = mean_ii - mean_i * mean_i;
+    Expr a = var_i / (var_i + eps);
+    Expr b = mean_i - a * mean_i;
+    Func sum_ab = summed_area_table(Tuple(a, b), x, y, width, height, "sum_ab");
+
+    Expr mean_a = box_sum(sum_ab, 0, x, y, width, height, radius) / n;
+    Expr mean_b = box_sum(sum_ab, 1, x, y, width, height, radius) / n;
+
+    Func dst("dst");
+    Expr q = mean_a * cast<double>(src(x, y)) + mean_b;
+    dst(x, y) = cast<T>(clamp(round(q), 0.0, cast<double>(type_of<T>().max())));
+
+    return dst;
+}
+
+// Histogram equalization of uint8_t. The LUT maps the CDF linearly from its first non-zero value to [0, 255],
+// and the whole pipeline (histogram, CDF, LUT and mapping) is generated together.
+Func equalize_hist(Func src, int32_t width, int32_t height)
+{
+    Var x{"x"}, y{"y"}, i{"i"};
+    const int32_t bins = 256;
+
+    Func hist = histogram<uint8_t>(src, width, height, bins);
+    schedule(hist, {bins});
+
+    Func cdf("cdf");
+    cdf(i) = hist(i);
+    RDom rc{1, bins - 1, "rc"};
+    cdf(rc) = cdf(rc - 1) + hist(rc);
+    schedule(cdf, {bins});
+
+    // CDF of the first non-zero bin
+    Expr total = cast<int64_t>(width) * height;
+    RDom rb{0, bins, "rb"};
+    Func cdf_min("cdf_min");
+    cdf_min(i) = minimum(select(hist(rb) > 0, cast<int64_t>(cdf(rb)), total));
+    schedule(cdf_min, {1});
+
+    // A constant image is left unchanged
+    Expr denom = total - cdf_min(0);
+    Expr num = max(cast<int64_t>(cdf(i)) - cdf_min(0), 0);
+    Func lut("lut");
+    lut(i) = select(denom > 0, cast<uint8_t>((num * 255 + denom / 2) / max(denom, 1)), cast<uint8_t>(i));
+    schedule(lut, {bins});
+
+    Func dst("dst");
+    dst(x, y) = lut(cast<int32_t>(src(x, y)));
+
+    return dst;
+}
+
+// Contrast limited adaptive histogram equalization (CLAHE) of uint8_t, compatible with OpenCV.
+// The image is divided into tiles_x x tiles_y tiles. The histogram of each tile is clipped at
+// clip_limit * (tile area) / 256, the excess is redistributed over all bins, and the CDF of each tile is its LUT.
+// Each pixel is mapped by bilinear blending of the LUTs of the four nearest tiles.
+// Tile histograms and LUTs are computed in parallel over tiles.
+Func clahe(Func src, int32_t width, int32_t height, int32_t tiles_x, int32_t tiles_y, Expr clip_limit)
+{
+    throw_assert(width % tiles_x == 0 && height % tiles_y == 0, "image size should be a multiple of the number of tiles");
+
+    Var x{"x"}, y{"y"}, i{"i"}, tx{"tx"}, ty{"ty"};
+    const int32_t bins = 256;
+    const int32_t tile_width = width / tiles_x;
+    const int32_t tile_height = height / tiles_y;
+    const int32_t area = tile_width * tile_height;
+
+    RDom r{0, tile_width, 0, tile_height, "r"};
+    Func hist("tile_hist");
+    hist(i, tx, ty) = 0;
+    hist(cast<int32_t>(src(tx * tile_width + r.x, ty * tile_height + r.y)), tx, ty) += 1;
+
+    // Clip and redistribute the excess: every bin gets batch, and residual bins spaced by step get one more
+    Expr clip = max(cast<int32_t>(clip_limit * area / bins), 1);
+    RDom rb{0, bins, "rb"};
+    Func excess("excess");
+    excess(tx, ty) = sum(max(hist(rb, tx, ty) - clip, 0));
+    Expr batch = excess(tx, ty) / bins;
+    Expr residual = excess(tx, ty) - batch * bins;
+    Expr step = max(bins / max(residual, 1), 1);
+    Expr extra = select(i % step == 0 && i / step < residual, 1, 0);
+
+    Func cdf("tile_cdf");
+    cdf(i, tx, ty) = min(hist(i, tx, ty), clip) + batch + extra;
+    RDom rc{1, bins - 1, "rc"};
+    cdf(rc, tx, ty) = cdf(rc - 1, tx, ty) + cdf(rc, tx, ty);
+
+    Func lut("tile_lut");
+    Expr lut_scale = static_cast<float>(bins - 1) / area;
+    lut(i, tx, ty) = cast<float>(cast<uint8_t>(clamp(round(cast<float>(cdf(i, tx, ty)) * lut_scale), 0.0f, 255.0f)));
+
+    schedule(hist, {bins, tiles_x, tiles_y});
+    schedule(excess, {tiles_x, tiles_y});
+    schedule(cdf, {bins, tiles_x, tiles_y});
+    schedule(lut, {bins, tiles_x, tiles_y});
+#if !defined(HALIDE_FOR_FPGA)
+    hist.update().parallel(ty);
+    cdf.parallel(ty);
+    cdf.update().parallel(ty);
+    lut.parallel(ty).vectorize(i, 8);
+#endif
+
+    // Position relative to the tile centers
+    Expr txf = cast<float>(x) * (1.0f / tile_width) - 0.5f;
+    Expr tyf = cast<float>(y) * (1.0f / tile_height) - 0.5f;
+    Expr tx1 = cast<int32_t>(floor(txf)), ty1 = cast<int32_t>(floor(tyf));
+    Expr xa = txf - tx1, ya = tyf - ty1;
+    Expr tx2 = min(tx1 + 1, tiles_x - 1), ty2 = min(ty1 + 1, tiles_y - 1);
+    tx1 = max(tx1, 0);
+    ty1 = max(ty1, 0);
+
+    Expr v = cast<int32_t>(src(x, y));
+    Expr res = (lut(v, tx1, ty1) * (1.0f - xa) + lut(v, tx2, ty1) * xa) * (1.0f - ya)
+             + (lut(v, tx1, ty2) * (1.0f - xa) + lut(v, tx2, ty2) * xa) * ya;
+
+    Func dst("dst");
+    dst(x, y) = cast<uint8_t>(clamp(round(res), 0.0f, 255.0f));
+
+    return dst;
+}
+
 template <typename T>
 Func scale_NN(Func src, int32_t in_width, int32_t in_height, int32_t out_width, int32_t out_height)
 {
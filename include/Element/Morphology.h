@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -13,10 +14,412 @@ namespace Halide {
 namespace Element {
 namespace{
 
+enum class MorphologyAlgorithm {
+    Direct,           // Reduction over the whole window for each pixel
+    VanHerkGilWerman, // Separable running max/min, O(1) per pixel regardless of window size
+    Binary,           // Bit-packed 0/max masks, 64 pixels per word
+    Decomposed        // Arbitrary structure as runs of rows, each run in O(1) by a sparse table
+};
+
+const std::map<std::string, MorphologyAlgorithm> morphology_algorithm_enum_map = {
+    {"direct", MorphologyAlgorithm::Direct},
+    {"vhgw",   MorphologyAlgorithm::VanHerkGilWerman},
+    {"binary", MorphologyAlgorithm::Binary},
+    {"decompose", MorphologyAlgorithm::Decomposed}
+};
+
+// Intermediate frames of iterated morphology, which are left unscheduled
+// so that schedule_fused() computes them per tile of the final output.
+using MorphologyStages = std::vector<Func>;
+
+// Materializes an intermediate frame, or defers it to schedule_fused() when stages is given.
+void schedule_iteration(Func f, const std::vector<Expr>& shape, MorphologyStages *stages)
+{
+    if (stages) {
+        stages->push_back(f);
+    } else {
+        schedule(f, shape);
+    }
+}
+
+// Computes stages together with their halos inside each tile (or row strip) of out,
+// so that only the input and the output of the whole chain go through memory.
+// None and Vectorize fall back to Tile, since per-row fusion recomputes too much halo.
+Func& schedule_fused(Func& out, MorphologyStages& stages, const std::vector<Expr>& shape, CPUSchedule policy, const Target& target)
+{
+#if defined(HALIDE_FOR_FPGA)
+    for (auto& f : stages) {
+        schedule(f, shape);
+    }
+#else
+    if (policy == CPUSchedule::None || policy == CPUSchedule::Vectorize) {
+        policy = CPUSchedule::Tile;
+    }
+    schedule_cpu(out, shape, policy, target);
+    for (auto& f : stages) {
+        schedule_cpu_at(f, out, policy, target);
+    }
+#endif
+    return out;
+}
+
+// One dimensional max (or min) filter over [p - window/2, p - window/2 + window) along dim,
+// by van Herk/Gil-Werman algorithm. The line is divided into blocks of window pixels,
+// and running extremums from the head and the tail of each block are combined with just one op.
+// in should be defined over [-window/2, extent + window - 1 - window/2) along dim.
+Func vhgw_pass(Func in, int32_t dim, int32_t extent, int32_t window, bool is_max, const std::string& name,
+               const Target& target = get_host_target())
+{
+    Var x{"x"}, y{"y"};
+    Var q = dim == 0 ? y : x;
+
+    const int32_t left = window / 2;
+    const int32_t right = window - 1 - left;
+    const int32_t n = extent + window - 1;
+
+    auto op = [is_max](Expr a, Expr b) { return is_max ? max(a, b) : min(a, b); };
+    auto at = [dim](Expr p, Expr q) { return dim == 0 ? std::vector<Expr>{p, q} : std::vector<Expr>{q, p}; };
+
+    Func head{name + "_head"}, tail{name + "_tail"};
+    head(x, y) = in(x, y);
+    tail(x, y) = in(x, y);
+
+    RDom rh{-left + 1, n - 1, name + "_rh"};
+    head(at(rh, q)) = select((rh + left) % window == 0,
+                             in(at(rh, q)),
+                             op(head(at(rh - 1, q)), in(at(rh, q))));
+
+    RDom rt{0, n - 1, name + "_rt"};
+    Expr p = extent + right - 2 - rt;
+    tail(at(p, q)) = select((p + left) % window == window - 1,
+                            in(at(p, q)),
+                            op(tail(at(p + 1, q)), in(at(p, q))));
+
+    Func out{name};
+    Var v = dim == 0 ? x : y;
+    out(x, y) = op(tail(at(v - left, q)), head(at(v + right, q)));
+
+    head.compute_root();
+    tail.compute_root();
+#if !defined(HALIDE_FOR_FPGA)
+    const int32_t vec = target.natural_vector_size(in.output_types()[0]);
+    auto schedule_scan = [&](Func f, RVar r) {
+        f.parallel(y).vectorize(x, vec);
+        if (dim == 0) {
+            // Scan along x, rows in parallel
+            f.update().parallel(y);
+        } else {
+            // Scan along y, vectorized across columns
+            Var xo{"xo"}, xi{"xi"};
+            f.update().split(x, xo, xi, vec * 4).reorder(xi, r, xo).parallel(xo).vectorize(xi, vec);
+        }
+    };
+    schedule_scan(head, rh.x);
+    schedule_scan(tail, rt.x);
+#endif
+
+    return out;
+}
+
+// The row and column scans of each pass span the whole frame, so intermediate frames are always materialized
+// and fuse_iterations has no effect on this algorithm.
+Func rect_vhgw(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration, bool is_max,
+               const Target& target = get_host_target())
+{
+    Func dst = src;
+
+    for (int32_t i = 0; i < iteration; i++) {
+        if (i != 0) {
+            schedule(dst, {width, height});
+#if !defined(HALIDE_FOR_FPGA)
+            dst.parallel(dst.args()[1]).vectorize(dst.args()[0], target.natural_vector_size(dst.output_types()[0]));
+#endif
+        }
+        Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
+
+        Func rows = vhgw_pass(clamped, 0, width, window_width, is_max, "rows" + std::to_string(i), target);
+        Func cols = vhgw_pass(rows, 1, height, window_height, is_max, "workbuf" + std::to_string(i), target);
+
+        dst = cols;
+    }
+
+    return dst;
+}
+
+//
+// Bit-packed binary morphology
+//
+// Pixel x of a row is stored in bit (x % 64) of word (x / 64).
+// Non-zero pixels are foreground, and unpack_binary() restores them as the max value of the type.
+const int32_t binary_word_bits = 64;
+
+int32_t binary_words(int32_t width)
+{
+    return (width + binary_word_bits - 1) / binary_word_bits;
+}
+
+Func pack_binary(Func src, int32_t width, int32_t height)
+{
+    Var xw{"xw"}, y{"y"};
+
+    Func clamped = BoundaryConditions::repeat_edge(src, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
+
+    Expr word = cast<uint64_t>(0);
+    for (int32_t b = 0; b < binary_word_bits; b++) {
+        word = word | select(clamped(xw * binary_word_bits + b, y) != 0, cast<uint64_t>(1) << b, cast<uint64_t>(0));
+    }
+
+    Func packed{"packed"};
+    packed(xw, y) = word;
+
+    return packed;
+}
+
 template<typename T>
-Func dilate(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, Func structure, int32_t iteration)
+Func unpack_binary(Func packed)
 {
     Var x{"x"}, y{"y"};
+
+    Func dst{"unpacked"};
+    Expr bit = (packed(x / binary_word_bits, y) >> cast<uint64_t>(x % binary_word_bits)) & cast<uint64_t>(1);
+    dst(x, y) = select(bit != 0, type_of<T>().max(), type_of<T>().min());
+
+    return dst;
+}
+
+// Extends packed rows like repeat_edge() does for pixels.
+// Unused bits of the last word are filled with the last pixel.
+Func binary_repeat_edge(Func packed, int32_t width, int32_t height)
+{
+    Var xw{"xw"}, y{"y"};
+
+    const int32_t words = binary_words(width);
+    const int32_t last_bits = width - (words - 1) * binary_word_bits;
+
+    auto fill = [](Expr bit) { return cast<uint64_t>(0) - bit; };
+    const Expr one = cast<uint64_t>(1);
+    const Expr valid = last_bits == binary_word_bits ? ~cast<uint64_t>(0) : (one << last_bits) - one;
+
+    Expr yc = clamp(y, 0, height - 1);
+    Expr last_word = packed(words - 1, yc);
+    Expr first = packed(0, yc) & one;
+    Expr last = (last_word >> (last_bits - 1)) & one;
+
+    Func dst{"binary_edge"};
+    dst(xw, y) = select(xw < 0, fill(first),
+                 select(xw >= words, fill(last),
+                 select(xw == words - 1, (last_word & valid) | (fill(last) & ~valid),
+                        packed(clamp(xw, 0, words - 1), yc))));
+
+    return dst;
+}
+
+// Pixels at x + d, moved to the bit of x.
+Expr binary_shift(Func packed, Expr xw, Expr y, int32_t d)
+{
+    if (d > 0) {
+        return (packed(xw, y) >> d) | (packed(xw + 1, y) << (binary_word_bits - d));
+    } else if (d < 0) {
+        return (packed(xw, y) << -d) | (packed(xw - 1, y) >> (binary_word_bits + d));
+    }
+    return packed(xw, y);
+}
+
+// One iteration of erode (AND) or dilate (OR) over packed rows.
+Func binary_pass(Func packed, int32_t width, int32_t height, int32_t window_width, int32_t window_height,
+                 bool cross, bool is_max, const std::string& name)
+{
+    Var xw{"xw"}, y{"y"};
+
+    auto op = [is_max](Expr a, Expr b) { return is_max ? (a | b) : (a & b); };
+
+    Func edge = binary_repeat_edge(packed, width, height);
+
+    Expr h = binary_shift(edge, xw, y, -(window_width / 2));
+    for (int32_t i = -(window_width / 2) + 1; i < -(window_width / 2) + window_width; i++) {
+        h = op(h, binary_shift(edge, xw, y, i));
+    }
+    Func rows{name + "_rows"};
+    rows(xw, y) = h;
+
+    Func src = cross ? edge : rows;
+    Expr v = src(xw, y - window_height / 2);
+    for (int32_t j = -(window_height / 2) + 1; j < -(window_height / 2) + window_height; j++) {
+        v = op(v, src(xw, y + j));
+    }
+
+    Func dst{name};
+    dst(xw, y) = cross ? op(rows(xw, y), v) : v;
+
+    return dst;
+}
+
+// Packed frames are small (one bit per pixel) and always materialized between iterations,
+// so fuse_iterations has no effect on this algorithm.
+template<typename T>
+Func morphology_binary(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration,
+                       bool cross, bool is_max)
+{
+    throw_assert(window_width <= binary_word_bits, "window_width should be less than or equal to 64.");
+
+    const int32_t words = binary_words(width);
+    const std::vector<Expr> shape = {words, height};
+
+    Func packed = pack_binary(src, width, height);
+
+    for (int32_t i = 0; i < iteration; i++) {
+        schedule(packed, shape);
+#if !defined(HALIDE_FOR_FPGA)
+        packed.parallel(packed.args()[1]);
+#endif
+        packed = binary_pass(packed, width, height, window_width, window_height, cross, is_max, "workbuf" + std::to_string(i));
+    }
+
+    schedule(packed, shape);
+#if !defined(HALIDE_FOR_FPGA)
+    packed.parallel(packed.args()[1]);
+#endif
+
+    return unpack_binary<T>(packed);
+}
+
+//
+// Structuring element decomposition
+//
+// Non-zero cells of each structure row are split into runs at run time.
+// The max (min) of a run of length len is taken from two overlapping power-of-two windows,
+// so that the cost per pixel is proportional to the number of runs instead of the number of cells.
+struct StructureRuns {
+    Func runs;  // runs(k) = {dx, dy, level, offset}: [dx, dx + offset + 2^level) on row dy
+    Func count; // count(0): number of runs
+    int32_t max_runs;
+    int32_t levels;
+};
+
+int32_t floor_log2(int32_t v)
+{
+    int32_t l = 0;
+    while ((2 << l) <= v) {
+        l++;
+    }
+    return l;
+}
+
+StructureRuns structure_runs(Func structure, int32_t window_width, int32_t window_height)
+{
+    Var i{"i"}, j{"j"}, k{"k"};
+
+    StructureRuns sr;
+    sr.max_runs = window_height * ((window_width + 1) / 2);
+    sr.levels = floor_log2(window_width) + 1;
+
+    auto on = [&](Expr x, Expr y) { return structure(x, y) != 0; };
+
+    // Length of the run from (i, j) to the right
+    Func length{"run_length"};
+    length(i, j) = 0;
+    RDom ri{0, window_width, "ri"};
+    Expr ic = window_width - 1 - ri;
+    length(ic, j) = select(on(ic, j), length(ic + 1, j) + 1, 0);
+    schedule(length, {window_width + 1, window_height});
+
+    Func start{"run_start"};
+    start(i, j) = on(i, j) && (i == 0 || !on(max(i - 1, 0), j));
+    schedule(start, {window_width, window_height});
+
+    // Number of runs before cell k in raster order
+    Func index{"run_index"};
+    index(k) = 0;
+    RDom rc{1, window_width * window_height, "rc"};
+    index(rc) = index(rc - 1) + select(start((rc - 1) % window_width, (rc - 1) / window_width), 1, 0);
+    schedule(index, {window_width * window_height + 1});
+
+    sr.count = Func{"run_count"};
+    sr.count(k) = index(window_width * window_height);
+    schedule(sr.count, {1});
+
+    RDom rs{0, window_width, 0, window_height, "rs"};
+    rs.where(start(rs.x, rs.y));
+    Expr len = length(rs.x, rs.y);
+    Expr level = 0;
+    for (int32_t l = 1; l < sr.levels; l++) {
+        level = select(len >= (1 << l), l, level);
+    }
+
+    sr.runs = Func{"runs"};
+    sr.runs(k) = Tuple(0, 0, 0, 0);
+    sr.runs(clamp(index(rs.y * window_width + rs.x), 0, sr.max_runs - 1)) =
+        Tuple(rs.x - window_width / 2, rs.y - window_height / 2, level, len - (Expr(1) << level));
+    schedule(sr.runs, {sr.max_runs});
+
+    return sr;
+}
+
+// One iteration over clamped input. An all zero structure picks the top left pixel as dilate/erode do.
+template<typename T>
+Func morphology_decomposed(Func clamped, int32_t window_width, int32_t window_height, const StructureRuns& sr,
+                           bool is_max, const std::string& name, const Target& target = get_host_target())
+{
+    Var x{"x"}, y{"y"}, l{"l"};
+
+    auto op = [is_max](Expr a, Expr b) { return is_max ? max(a, b) : min(a, b); };
+
+    // table[lv](x, y): max (min) over [x, x + 2^lv)
+    std::vector<Func> table(sr.levels);
+    table[0] = clamped;
+    for (int32_t lv = 1; lv < sr.levels; lv++) {
+        table[lv] = Func{name + "_level" + std::to_string(lv)};
+        table[lv](x, y) = op(table[lv - 1](x, y), table[lv - 1](x + (1 << (lv - 1)), y));
+    }
+
+    Func stacked{name + "_table"};
+    Expr e = table[sr.levels - 1](x, y);
+    for (int32_t lv = sr.levels - 2; lv >= 0; lv--) {
+        e = select(l == lv, table[lv](x, y), e);
+    }
+    stacked(x, y, l) = e;
+
+    RDom rr{0, sr.max_runs, name + "_rr"};
+    rr.where(rr < sr.count(0));
+    // Clamping lets bounds inference see the extent of the window.
+    Expr dx = clamp(sr.runs(rr)[0], -(window_width / 2), window_width - 1 - window_width / 2);
+    Expr dy = clamp(sr.runs(rr)[1], -(window_height / 2), window_height - 1 - window_height / 2);
+    Expr lv = clamp(sr.runs(rr)[2], 0, sr.levels - 1);
+    Expr offset = clamp(sr.runs(rr)[3], 0, window_width - 1);
+
+    Func dst{name};
+    dst(x, y) = select(sr.count(0) == 0,
+                       clamped(x - window_width / 2, y - window_height / 2),
+                       is_max ? type_of<T>().min() : type_of<T>().max());
+    dst(x, y) = op(dst(x, y), op(stacked(x + dx, y + dy, lv), stacked(x + dx + offset, y + dy, lv)));
+
+    for (int32_t lv = 1; lv < sr.levels; lv++) {
+        table[lv].compute_at(dst, Var::outermost());
+    }
+    stacked.compute_at(dst, Var::outermost()).bound(l, 0, sr.levels).unroll(l);
+#if !defined(HALIDE_FOR_FPGA)
+    const int32_t vec = target.natural_vector_size(type_of<T>());
+    for (int32_t lv = 1; lv < sr.levels; lv++) {
+        table[lv].parallel(y).vectorize(x, vec);
+    }
+    stacked.parallel(y).vectorize(x, vec);
+    // Runs are the outer loop of each row strip, so that the predicate is checked once per strip.
+    Var yo{"yo"}, yi{"yi"};
+    dst.update().split(y, yo, yi, cpu_rows_per_task).reorder(x, yi, rr, yo).parallel(yo).vectorize(x, vec);
+#endif
+
+    return dst;
+}
+
+template<typename T>
+Func dilate(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, Func structure, int32_t iteration,
+            MorphologyAlgorithm algorithm = MorphologyAlgorithm::Direct, MorphologyStages *stages = nullptr,
+            const Target& target = get_host_target())
+{
+    throw_assert(algorithm == MorphologyAlgorithm::Direct || algorithm == MorphologyAlgorithm::Decomposed,
+                 "only direct and decompose are supported for arbitrary structure.");
+
+    Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
 
     Func allzero{"allzero"};
@@ -24,14 +427,25 @@ Func dilate(Func src, int32_t width, int32_t height, int32_t window_width, int32
     allzero(x) = allzero(x) && (structure(r.x + window_width / 2, r.y + window_height / 2) == 0);
     schedule(allzero, {1});
 
+    const bool decomposed = algorithm == MorphologyAlgorithm::Decomposed;
+    StructureRuns sr;
+    if (decomposed) {
+        sr = structure_runs(structure, window_width, window_height);
+    }
+
     Func dst = src;
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
+        if (decomposed) {
+            dst = morphology_decomposed<T>(clamped, window_width, window_height, sr, true, "workbuf" + std::to_string(i), target);
+            continue;
+        }
+
         Func workbuf{"workbuf" + std::to_string(i)};
         workbuf(x, y) = select(allzero(0),
                                clamped(x - window_width / 2, y - window_height / 2),
@@ -45,8 +459,17 @@ Func dilate(Func src, int32_t width, int32_t height, int32_t window_width, int32
 }
 
 template<typename T>
-Func dilate_rect(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration)
+Func dilate_rect(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration,
+                 MorphologyAlgorithm algorithm = MorphologyAlgorithm::Direct, MorphologyStages *stages = nullptr,
+                 const Target& target = get_host_target())
 {
+    if (algorithm == MorphologyAlgorithm::VanHerkGilWerman) {
+        return rect_vhgw(src, width, height, window_width, window_height, iteration, true, target);
+    }
+    if (algorithm == MorphologyAlgorithm::Binary) {
+        return morphology_binary<T>(src, width, height, window_width, window_height, iteration, false, true);
+    }
+
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
 
@@ -54,7 +477,7 @@ Func dilate_rect(Func src, int32_t width, int32_t height, int32_t window_width,
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
@@ -68,8 +491,14 @@ Func dilate_rect(Func src, int32_t width, int32_t height, int32_t window_width,
 }
 
 template<typename T>
-Func dilate_cross(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration)
+Func dilate_cross(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration,
+                  MorphologyAlgorithm algorithm = MorphologyAlgorithm::Direct, MorphologyStages *stages = nullptr)
 {
+    throw_assert(algorithm != MorphologyAlgorithm::VanHerkGilWerman, "vhgw is not supported for cross window.");
+    if (algorithm == MorphologyAlgorithm::Binary) {
+        return morphology_binary<T>(src, width, height, window_width, window_height, iteration, true, true);
+    }
+
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
     r.where(r.x == 0 || r.y == 0);
@@ -78,7 +507,7 @@ Func dilate_cross(Func src, int32_t width, int32_t height, int32_t window_width,
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
@@ -91,7 +520,8 @@ Func dilate_cross(Func src, int32_t width, int32_t height, int32_t window_width,
     return dst;
 }
 
-Func conv_rect(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int32_t height, int32_t iteration, int32_t window_width, int32_t window_height) {
+Func conv_rect(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int32_t height, int32_t iteration, int32_t window_width, int32_t window_height,
+               MorphologyStages *stages = nullptr) {
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
 
@@ -99,7 +529,7 @@ Func conv_rect(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int32
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
@@ -113,7 +543,8 @@ Func conv_rect(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int32
 }
 
 
-Func conv_cross(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int32_t height, int32_t iteration, int32_t window_width, int32_t window_height) {
+Func conv_cross(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int32_t height, int32_t iteration, int32_t window_width, int32_t window_height,
+                MorphologyStages *stages = nullptr) {
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
     r.where(r.x == 0 || r.y == 0);
@@ -122,7 +553,7 @@ Func conv_cross(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int3
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
@@ -137,7 +568,8 @@ Func conv_cross(Func src, std::function<Expr(RDom, Expr)> f, int32_t width, int3
 
 
 Func conv_with_structure(Func src, std::function<Expr(RDom, Expr)> f, Expr init, Func structure,
-                         int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration) {
+                         int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration,
+                         MorphologyStages *stages = nullptr) {
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
 
@@ -150,7 +582,7 @@ Func conv_with_structure(Func src, std::function<Expr(RDom, Expr)> f, Expr init,
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
@@ -167,8 +599,13 @@ Func conv_with_structure(Func src, std::function<Expr(RDom, Expr)> f, Expr init,
 }
 
 template<typename T>
-Func erode(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, Func structure, int32_t iteration)
+Func erode(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, Func structure, int32_t iteration,
+           MorphologyAlgorithm algorithm = MorphologyAlgorithm::Direct, MorphologyStages *stages = nullptr,
+           const Target& target = get_host_target())
 {
+    throw_assert(algorithm == MorphologyAlgorithm::Direct || algorithm == MorphologyAlgorithm::Decomposed,
+                 "only direct and decompose are supported for arbitrary structure.");
+
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
 
@@ -177,14 +614,25 @@ Func erode(Func src, int32_t width, int32_t height, int32_t window_width, int32_
     allzero(x) = allzero(x) && (structure(r.x + window_width / 2, r.y + window_height / 2) == 0);
     schedule(allzero, {1});
 
+    const bool decomposed = algorithm == MorphologyAlgorithm::Decomposed;
+    StructureRuns sr;
+    if (decomposed) {
+        sr = structure_runs(structure, window_width, window_height);
+    }
+
     Func dst = src;
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
+        if (decomposed) {
+            dst = morphology_decomposed<T>(clamped, window_width, window_height, sr, false, "workbuf" + std::to_string(i), target);
+            continue;
+        }
+
         Func workbuf("workbuf" + std::to_string(i));
         workbuf(x, y) = select(allzero(0),
                                clamped(x - window_width / 2, y - window_height / 2),
@@ -199,8 +647,14 @@ Func erode(Func src, int32_t width, int32_t height, int32_t window_width, int32_
 }
 
 template<typename T>
-Func erode_cross(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration)
+Func erode_cross(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration,
+                 MorphologyAlgorithm algorithm = MorphologyAlgorithm::Direct, MorphologyStages *stages = nullptr)
 {
+    throw_assert(algorithm != MorphologyAlgorithm::VanHerkGilWerman, "vhgw is not supported for cross window.");
+    if (algorithm == MorphologyAlgorithm::Binary) {
+        return morphology_binary<T>(src, width, height, window_width, window_height, iteration, true, false);
+    }
+
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
     r.where(r.x == 0 || r.y == 0);
@@ -209,7 +663,7 @@ Func erode_cross(Func src, int32_t width, int32_t height, int32_t window_width,
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
@@ -223,8 +677,17 @@ Func erode_cross(Func src, int32_t width, int32_t height, int32_t window_width,
 }
 
 template<typename T>
-Func erode_rect(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration)
+Func erode_rect(Func src, int32_t width, int32_t height, int32_t window_width, int32_t window_height, int32_t iteration,
+                MorphologyAlgorithm algorithm = MorphologyAlgorithm::Direct, MorphologyStages *stages = nullptr,
+                const Target& target = get_host_target())
 {
+    if (algorithm == MorphologyAlgorithm::VanHerkGilWerman) {
+        return rect_vhgw(src, width, height, window_width, window_height, iteration, false, target);
+    }
+    if (algorithm == MorphologyAlgorithm::Binary) {
+        return morphology_binary<T>(src, width, height, window_width, window_height, iteration, false, false);
+    }
+
     Var x{"x"}, y{"y"};
     RDom r{-(window_width / 2), window_width, -(window_height / 2), window_height};
 
@@ -232,7 +695,7 @@ Func erode_rect(Func src, int32_t width, int32_t height, int32_t window_width, i
 
     for (int32_t i = 0; i < iteration; i++) {
         if (i != 0) {
-            schedule(dst, {width, height});
+            schedule_iteration(dst, {width, height}, stages);
         }
         Func clamped = BoundaryConditions::repeat_edge(dst, {{0, cast<int32_t>(width)}, {0, cast<int32_t>(height)}});
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <map>
+#include <string>
 #include <vector>
 
 #include <Halide.h>
@@ -125,6 +128,186 @@ Func& set_extent_interval(Func& f, const std::vector<std::pair<int32_t, int32_t>
     return f;
 }
 
+//
+// CPU scheduling
+//
+// The schedule() family above only places Funcs at root with static bounds, which is what the
+// FPGA backend expects. The following helpers add CPU loop transformations on top of it and
+// do nothing when building for FPGA, so generators can call them unconditionally.
+//
+enum class CPUSchedule {
+    None,               // compute_root + bound only
+    Parallel,           // row strips distributed over threads
+    Vectorize,          // innermost spatial dimension vectorized by natural vector width
+    ParallelVectorize,  // both of above
+    Tile                // 2D tiles, tile rows in parallel, vectorized inside a tile
+};
+
+const std::map<std::string, CPUSchedule> cpu_schedule_enum_map = {
+    {"none",               CPUSchedule::None},
+    {"parallel",           CPUSchedule::Parallel},
+    {"vectorize",          CPUSchedule::Vectorize},
+    {"parallel_vectorize", CPUSchedule::ParallelVectorize},
+    {"tile",               CPUSchedule::Tile}
+};
+
+const int32_t cpu_rows_per_task = 8;
+const int32_t cpu_tile_width = 64;
+const int32_t cpu_tile_height = 32;
+
+// Clamps split factor by the extent when it is known at compile time.
+int32_t fit_factor(Expr extent, int32_t factor)
+{
+    const int64_t *e = Internal::as_const_int(Internal::simplify(extent));
+    return e ? static_cast<int32_t>(std::min(*e, static_cast<int64_t>(factor))) : factor;
+}
+
+// Picks spatial dimensions. For (c, x, y) layouts channel is left as innermost loop.
+void cpu_schedule_vars(const Func& f, Var& x, Var& y, int32_t& x_index)
+{
+    const std::vector<Var> args = f.args();
+    x_index = args.size() >= 3 ? static_cast<int32_t>(args.size()) - 2 : 0;
+    x = args[x_index];
+    y = args.back();
+}
+
+Func& schedule_cpu(Func& f, const std::vector<Expr>& shape, CPUSchedule policy, const Target& target)
+{
+#if !defined(HALIDE_FOR_FPGA)
+    if (policy == CPUSchedule::None) {
+        return f;
+    }
+    assert(static_cast<size_t>(f.dimensions()) == shape.size());
+
+    Var x, y;
+    int32_t x_index;
+    cpu_schedule_vars(f, x, y, x_index);
+    const bool has_y = f.dimensions() >= 2;
+
+    Var xo{x.name() + "_o"}, xi{x.name() + "_i"};
+    Var yo{y.name() + "_o"}, yi{y.name() + "_i"};
+
+    const int32_t vec = target.natural_vector_size(f.output_types()[0]);
+    const int32_t vec_x = fit_factor(shape[x_index], vec);
+    const bool vectorizable = vec_x == vec && vec > 1;
+
+    switch (policy) {
+    case CPUSchedule::Parallel:
+    case CPUSchedule::ParallelVectorize:
+        if (has_y) {
+            f.split(y, yo, yi, fit_factor(shape.back(), cpu_rows_per_task)).parallel(yo);
+        }
+        if (policy == CPUSchedule::ParallelVectorize && vectorizable) {
+            f.vectorize(x, vec);
+        }
+        break;
+    case CPUSchedule::Vectorize:
+        if (vectorizable) {
+            f.vectorize(x, vec);
+        }
+        break;
+    case CPUSchedule::Tile:
+        if (has_y) {
+            const int32_t tw = fit_factor(shape[x_index], std::max(cpu_tile_width, vec));
+            const int32_t th = fit_factor(shape.back(), cpu_tile_height);
+            f.tile(x, y, xo, yo, xi, yi, tw, th).parallel(yo);
+            if (vectorizable && tw % vec == 0) {
+                f.vectorize(xi, vec);
+            }
+        } else if (vectorizable) {
+            f.vectorize(x, vec);
+        }
+        break;
+    default:
+        break;
+    }
+#endif
+    return f;
+}
+
+// Fuses an intermediate Func into the loop nest which schedule_cpu() produced for consumer.
+// f should not be bounded by schedule(), otherwise every strip or tile computes the whole frame.
+Func& schedule_cpu_at(Func& f, Func& consumer, CPUSchedule policy, const Target& target)
+{
+#if !defined(HALIDE_FOR_FPGA)
+    if (policy == CPUSchedule::None) {
+        return f;
+    }
+    throw_assert(consumer.dimensions() >= 2, "consumer should have at least 2 dimensions.");
+
+    Var x, y;
+    int32_t x_index;
+    cpu_schedule_vars(consumer, x, y, x_index);
+
+    switch (policy) {
+    case CPUSchedule::Parallel:
+    case CPUSchedule::ParallelVectorize:
+        f.compute_at(consumer, Var(y.name() + "_o"));
+        break;
+    case CPUSchedule::Vectorize:
+        f.compute_at(consumer, y);
+        break;
+    case CPUSchedule::Tile:
+        f.compute_at(consumer, Var(x.name() + "_o"));
+        break;
+    default:
+        break;
+    }
+
+    if (policy != CPUSchedule::Parallel && f.dimensions() >= 1) {
+        Var fx, fy;
+        int32_t fx_index;
+        cpu_schedule_vars(f, fx, fy, fx_index);
+        const int32_t vec = target.natural_vector_size(f.output_types()[0]);
+        if (vec > 1) {
+            f.vectorize(fx, vec);
+        }
+    }
+#endif
+    return f;
+}
+
+//
+// Runtime sized scheduling
+//
+// Resolutions which get their own constant folded branch in specialize_dynamic().
+const std::vector<std::pair<int32_t, int32_t>> common_resolutions = {
+    {640, 480},   // VGA
+    {1280, 720},  // 720p
+    {1920, 1080}, // 1080p
+    {3840, 2160}  // 4K
+};
+
+// Lets extents and strides of ip be given by the input buffer at run time.
+ImageParam& schedule_dynamic(ImageParam& ip)
+{
+    for (int32_t i=0; i<ip.dimensions(); ++i) {
+        ip.dim(i).set_min(0);
+    }
+    return ip;
+}
+
+// Specializes f for dense layout of ip, and for common resolutions on top of it.
+// Spatial dimensions of ip are assumed to be the last two.
+Func& specialize_dynamic(Func& f, ImageParam& ip)
+{
+#if !defined(HALIDE_FOR_FPGA)
+    const int32_t n = ip.dimensions();
+    throw_assert(n >= 2, "ip should have at least 2 dimensions.");
+
+    Expr dense = ip.dim(0).stride() == 1;
+    for (int32_t i=1; i<n; ++i) {
+        dense = dense && ip.dim(i).stride() == ip.dim(i - 1).stride() * ip.dim(i - 1).extent();
+    }
+
+    for (auto& r : common_resolutions) {
+        f.specialize(dense && ip.dim(n - 2).extent() == r.first && ip.dim(n - 1).extent() == r.second);
+    }
+    f.specialize(dense);
+#endif
+    return f;
+}
+
 } // anonymous
 } // Element
 } // Halide
@@ -0,0 +1,183 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "HalideBuffer.h"
+#include "HalideRuntime.h"
+
+//
+// Benchmark runs only in the binary built by "make bench", which defines HALIDE_ELEMENT_BENCH.
+// Otherwise bench() does nothing and the test behaves as before.
+//
+// It is configured by the following environment variables.
+//   BENCH_WARMUP     : number of untimed runs (default: 10)
+//   BENCH_ITERATIONS : number of timed runs (default: 100)
+//   BENCH_JSON       : output file (default: <module>_bench.json)
+//
+// Results are named <module>_<variant> when BENCH_VARIANT (the TYPE_LIST entry) is defined,
+// and <module>_<buffer types> otherwise.
+//
+#ifndef BENCH_NAME
+#define BENCH_NAME "bench"
+#endif
+
+namespace {
+
+struct BenchResult {
+    std::string name;
+    int32_t iterations;
+    double min_ms;
+    double median_ms;
+    double p99_ms;
+    double mean_ms;
+    uint64_t pixels;
+    uint64_t bytes;
+};
+
+int32_t bench_env(const char *name, int32_t default_value)
+{
+    const char *v = getenv(name);
+    return v ? std::max(atoi(v), 1) : default_value;
+}
+
+class BenchReport {
+public:
+    std::vector<BenchResult> results;
+
+    ~BenchReport()
+    {
+        if (results.empty()) {
+            return;
+        }
+
+        const char *env = getenv("BENCH_JSON");
+        const std::string fname = env ? env : std::string(BENCH_NAME) + "_bench.json";
+        FILE *fp = fopen(fname.c_str(), "w");
+        if (fp == NULL) {
+            fprintf(stderr, "Cannot open %s\n", fname.c_str());
+            return;
+        }
+
+        fprintf(fp, "{\n  \"module\": \"%s\",\n  \"results\": [\n", BENCH_NAME);
+        for (size_t i=0; i<results.size(); ++i) {
+            const BenchResult& r = results[i];
+            const double sec = r.median_ms / 1000.0;
+            fprintf(fp, "    {\"name\": \"%s\", \"iterations\": %d, "
+                        "\"min_ms\": %.6f, \"median_ms\": %.6f, \"p99_ms\": %.6f, \"mean_ms\": %.6f, "
+                        "\"pixels\": %llu, \"bytes\": %llu, \"mpixels_per_sec\": %.3f, \"bytes_per_sec\": %.1f}%s\n",
+                    r.name.c_str(), r.iterations,
+                    r.min_ms, r.median_ms, r.p99_ms, r.mean_ms,
+                    static_cast<unsigned long long>(r.pixels), static_cast<unsigned long long>(r.bytes),
+                    r.pixels / sec / 1e6, r.bytes / sec,
+                    i + 1 == results.size() ? "" : ",");
+        }
+        fprintf(fp, "  ]\n}\n");
+        fclose(fp);
+    }
+};
+
+BenchReport& bench_report()
+{
+    static BenchReport report;
+    return report;
+}
+
+std::string bench_type_name(const halide_type_t& t)
+{
+    const char *prefix = t.code == halide_type_uint ? "u" :
+                         t.code == halide_type_int ? "i" :
+                         t.code == halide_type_float ? "f" : "h";
+    return prefix + std::to_string(t.bits);
+}
+
+struct BenchTraffic {
+    uint64_t pixels = 0;
+    uint64_t bytes = 0;
+    std::vector<std::string> types;
+};
+
+template<typename T>
+void bench_count(BenchTraffic& traffic, const Halide::Runtime::Buffer<T>& buf)
+{
+    // The largest buffer is regarded as the frame, and all buffers are read or written once.
+    traffic.pixels = std::max(traffic.pixels, static_cast<uint64_t>(buf.number_of_elements()));
+    traffic.bytes += buf.size_in_bytes();
+    const std::string name = bench_type_name(buf.type());
+    if (std::find(traffic.types.begin(), traffic.types.end(), name) == traffic.types.end()) {
+        traffic.types.push_back(name);
+    }
+}
+
+template<typename T>
+void bench_count(BenchTraffic&, const T&)
+{
+}
+
+// Runs func(args...) repeatedly and records its latency.
+template<typename F, typename... Args>
+void bench(F func, Args&&... args)
+{
+#ifdef HALIDE_ELEMENT_BENCH
+    BenchTraffic traffic;
+    int dummy[] = {0, (bench_count(traffic, args), 0)...};
+    (void)dummy;
+
+#ifdef BENCH_VARIANT
+    const std::string name = std::string(BENCH_NAME) + "_" + BENCH_VARIANT;
+#else
+    std::string name = BENCH_NAME;
+    for (auto& t : traffic.types) {
+        name += "_" + t;
+    }
+#endif
+
+    const int32_t warmup = bench_env("BENCH_WARMUP", 10);
+    const int32_t iterations = bench_env("BENCH_ITERATIONS", 100);
+
+    for (int32_t i=0; i<warmup; ++i) {
+        func(args...);
+    }
+
+    std::vector<double> elapsed(iterations);
+    for (int32_t i=0; i<iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func(args...);
+        auto end = std::chrono::high_resolution_clock::now();
+        elapsed[i] = std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    BenchResult r;
+    r.name = name;
+    r.iterations = iterations;
+    r.mean_ms = 0;
+    for (auto e : elapsed) {
+        r.mean_ms += e;
+    }
+    r.mean_ms /= iterations;
+    std::sort(elapsed.begin(), elapsed.end());
+    r.min_ms = elapsed.front();
+    r.median_ms = elapsed[iterations / 2];
+    r.p99_ms = elapsed[std::max(0, (iterations * 99 + 99) / 100 - 1)];
+    r.pixels = traffic.pixels;
+    r.bytes = traffic.bytes;
+
+    const double sec = r.median_ms / 1000.0;
+    printf("[bench] %s: min %.3f ms, median %.3f ms, p99 %.3f ms, %.2f MP/s, %.2f MB/s\n",
+           r.name.c_str(), r.min_ms, r.median_ms, r.p99_ms, r.pixels / sec / 1e6, r.bytes / sec / 1e6);
+
+    bench_report().results.push_back(r);
+#else
+    (void)func;
+#endif
+}
+
+} // anonymous namespace
+
+#endif /* BENCH_COMMON_H */
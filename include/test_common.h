@@ -1,11 +1,15 @@
 #ifndef TEST_COMMON_H
 #define TEST_COMMON_H
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <exception>
 #include <fstream>
+#include <iostream>
 #include <limits>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -184,6 +188,69 @@ void save_ppm(const std::string& fname, Halide::Runtime::Buffer<uint8_t>& buffer
 }
 
 
+// Runs two variants of an image-to-image module, e.g. with and without a schedule option, on the same random input,
+// and checks that their outputs are exactly the same.
+template<typename T, typename F>
+int test_same_output(F func, F reference, const int width = 1024, const int height = 768)
+{
+    try {
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<T>(extents);
+        auto expect = mk_null_buffer<T>(extents);
+        auto actual = mk_null_buffer<T>(extents);
+
+        reference(input, expect);
+        func(input, actual);
+
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                if (expect(x, y) != actual(x, y)) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %f, actual(%d, %d) = %f",
+                                                    x, y, static_cast<double>(expect(x, y)),
+                                                    x, y, static_cast<double>(actual(x, y))).c_str());
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+// Checks output(d, i) of min_pos_topk/max_pos_topk, which is the position of the i-th of the k smallest (largest)
+// pixels of input, against a stable sort of the whole frame. Pixels of the same value are in raster order.
+template<typename T>
+void check_pos_topk(Halide::Runtime::Buffer<T>& input, Halide::Runtime::Buffer<uint32_t>& output, int k, bool is_max)
+{
+    const int width = input.width();
+    const int height = input.height();
+
+    std::vector<int> index(width * height);
+    for (int i=0; i<width * height; ++i) {
+        index[i] = i;
+    }
+    std::stable_sort(index.begin(), index.end(), [&](int a, int b) {
+        const T va = input(a % width, a / width);
+        const T vb = input(b % width, b / width);
+        return is_max ? va > vb : va < vb;
+    });
+
+    for (int i=0; i<k; ++i) {
+        const uint32_t expect_x = index[i] % width;
+        const uint32_t expect_y = index[i] / width;
+        const uint32_t actual_x = output(0, i);
+        const uint32_t actual_y = output(1, i);
+        if (expect_x != actual_x || expect_y != actual_y) {
+            throw std::runtime_error(format("Error: %d-th, expect = (%u, %u), actual = (%u, %u)",
+                                            i, expect_x, expect_y, actual_x, actual_y));
+        }
+    }
+}
+
 template<typename T>
 T round_to_nearest_even(double v)
 {
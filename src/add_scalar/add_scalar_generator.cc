@@ -6,6 +6,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class AddScalar : public Halide::Generator<AddScalar<T>> {
@@ -14,6 +15,7 @@ class AddScalar : public Halide::Generator<AddScalar<T>> {
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
 public:
     Func build() {
@@ -23,6 +25,7 @@ public:
 
         schedule(src, {width, height});
         schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
 
         return dst;
     }
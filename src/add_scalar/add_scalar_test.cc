@@ -12,6 +12,7 @@
 #include "add_scalar_u32.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 
 template<typename T>
@@ -31,6 +32,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, double _value, struct
         auto output = mk_null_buffer<T>(extents);
 
         func(input, value, output);
+        bench(func, input, value, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -6,6 +6,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 class Affine : public Generator<Affine> {
 public:
@@ -19,6 +20,7 @@ public:
 
     GeneratorParam<int32_t> width{"width", 768};
     GeneratorParam<int32_t> height{"height", 1280};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Func build() {
         Func output{"output"};
@@ -27,6 +29,7 @@ public:
 
         schedule(input, {width, height});
         schedule(output, {width, height});
+        schedule_cpu(output, {width, height}, cpu_schedule, this->get_target());
 
         return output;
     }
@@ -5,6 +5,7 @@
 
 #include "affine.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using std::string;
 using std::vector;
@@ -31,6 +32,7 @@ int main()
         float skew_y = 30.0f;
 
         affine(input, degrees, scale_x, scale_y, shift_x, shift_y, skew_y, output);
+        bench(affine, input, degrees, scale_x, scale_y, shift_x, shift_y, skew_y, output);
         // operations are applied in the following order:
         //   1. scale about the origin
         //   2. shear in y direction
@@ -5,6 +5,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class AndScalar : public Halide::Generator<AndScalar<T>> {
@@ -13,6 +14,7 @@ class AndScalar : public Halide::Generator<AndScalar<T>> {
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
 public:
     Func build() {
@@ -22,6 +24,7 @@ public:
 
         schedule(src, {width, height});
         schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
 
         return dst;
     }
@@ -12,6 +12,7 @@
 #include "average_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer))
@@ -34,6 +35,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<T>(extents);
 
         func(input, output);
+        bench(func, input, output);
 
         const int32_t wx_lower = -window_width / 2;
         const int32_t wx_upper = wx_lower + window_width;
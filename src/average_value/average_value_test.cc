@@ -11,6 +11,7 @@
 #include "HalideRuntime.h"
 #include "HalideBuffer.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using std::string;
 using std::vector;
@@ -29,6 +30,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer,
         auto output = mk_null_buffer<D>({1});
 
         func(input, roi, output);
+        bench(func, input, roi, output);
         //reference
         D expect;
         double sum = 0;
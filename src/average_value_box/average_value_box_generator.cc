@@ -0,0 +1,41 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename S, typename D>
+class AverageValueBox : public Halide::Generator<AverageValueBox<S, D>> {
+public:
+    ImageParam src{type_of<S>(), 2, "src"};
+    ImageParam roi{type_of<uint8_t>(), 2, "roi"};
+    Param<int32_t> box_x{"box_x", 0};
+    Param<int32_t> box_y{"box_y", 0};
+    Param<int32_t> box_width{"box_width", 1};
+    Param<int32_t> box_height{"box_height", 1};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+
+    Func build() {
+        Func dst{"dst"};
+
+        dst = Element::average_value_box<D>(src, roi, width, height, box_x, box_y, box_width, box_height);
+
+        schedule(src, {width, height});
+        schedule(roi, {width, height});
+        schedule(dst, {1});
+
+        return dst;
+    }
+};
+
+using AverageValueBox_u8_f32 = AverageValueBox<uint8_t, float>;
+HALIDE_REGISTER_GENERATOR(AverageValueBox_u8_f32, average_value_box_u8_f32);
+using AverageValueBox_u16_f32 = AverageValueBox<uint16_t, float>;
+HALIDE_REGISTER_GENERATOR(AverageValueBox_u16_f32, average_value_box_u16_f32);
+using AverageValueBox_u8_f64 = AverageValueBox<uint8_t, double>;
+HALIDE_REGISTER_GENERATOR(AverageValueBox_u8_f64, average_value_box_u8_f64);
+using AverageValueBox_u16_f64 = AverageValueBox<uint16_t, double>;
+HALIDE_REGISTER_GENERATOR(AverageValueBox_u16_f64, average_value_box_u16_f64);
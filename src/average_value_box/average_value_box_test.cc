@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "average_value_box_u8_f32.h"
+#include "average_value_box_u16_f32.h"
+#include "average_value_box_u8_f64.h"
+#include "average_value_box_u16_f64.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+template <typename S, typename D>
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_roi_buffer,
+                     int32_t _box_x, int32_t _box_y, int32_t _box_width, int32_t _box_height,
+                     struct halide_buffer_t *_dst_buffer))
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<S>(extents);
+        auto output = mk_null_buffer<D>({1});
+
+        // Only the pixels of roi in the box are counted, though roi is not 0 outside of it
+        auto roi = mk_rand_buffer<uint8_t>(extents);
+        // {x, y, width, height} of the box at the center, at the corners of the frame, overhanging the frame,
+        // outside of the frame, and at the center again after roi is cleared in it, where no pixel is counted
+        const std::vector<std::array<int32_t, 4>> boxes{
+            {480, 352, 64, 48}, {0, 0, 64, 48}, {width - 64, height - 48, 64, 48},
+            {-16, -16, 64, 48}, {width - 32, height - 24, 64, 48}, {width, 0, 64, 48}, {480, 352, 64, 48}
+        };
+
+        for (size_t n=0; n<boxes.size(); ++n) {
+            const int32_t box_x = boxes[n][0], box_y = boxes[n][1], box_width = boxes[n][2], box_height = boxes[n][3];
+            if (n == boxes.size() - 1) {
+                for (int y=box_y; y<box_y+box_height; ++y) {
+                    for (int x=box_x; x<box_x+box_width; ++x) {
+                        roi(x, y) = 0;
+                    }
+                }
+            }
+
+            func(input, roi, box_x, box_y, box_width, box_height, output);
+            if (n == 0) {
+                bench(func, input, roi, box_x, box_y, box_width, box_height, output);
+            }
+
+            double sum = 0;
+            int count = 0;
+            // Only the part of the box in the frame is visited
+            const int x0 = std::max(box_x, 0), x1 = std::min(box_x + box_width, width);
+            const int y0 = std::max(box_y, 0), y1 = std::min(box_y + box_height, height);
+            for (int y=y0; y<y1; ++y) {
+                for (int x=x0; x<x1; ++x) {
+                    if (roi(x, y) == 0) {
+                        continue;
+                    }
+                    sum += input(x, y);
+                    count++;
+                }
+            }
+            const D expect = count == 0 ? 0 : static_cast<D>(sum / count);
+            const D actual = output(0);
+            if (expect != actual) {
+                throw std::runtime_error(format("Error: case %zu, expect = %f, actual = %f", n, expect, actual));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main()
+{
+#ifdef TYPE_u8_f32
+    test<uint8_t, float>(average_value_box_u8_f32);
+#endif
+#ifdef TYPE_u16_f32
+    test<uint16_t, float>(average_value_box_u16_f32);
+#endif
+#ifdef TYPE_u8_f64
+    test<uint8_t, double>(average_value_box_u8_f64);
+#endif
+#ifdef TYPE_u16_f64
+    test<uint16_t, double>(average_value_box_u16_f64);
+#endif
+}
@@ -0,0 +1,41 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename S, typename D>
+class AverageValueSpans : public Halide::Generator<AverageValueSpans<S, D>> {
+public:
+    ImageParam src{type_of<S>(), 2, "src"};
+    ImageParam spans{Int(32), 2, "spans"};
+    Param<int32_t> num_spans{"num_spans", 0};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<int32_t> max_spans{"max_spans", 1024};
+
+    Func build() {
+        Func dst{"dst"};
+
+        // Asserts are off, so num_spans is also clamped to the spans buffer
+        num_spans.set_range(0, max_spans);
+        dst = Element::average_value_spans<D>(src, width, height, spans, clamp(num_spans, 0, max_spans), width);
+
+        schedule(src, {width, height});
+        schedule(spans, {3, max_spans});
+        schedule(dst, {1});
+
+        return dst;
+    }
+};
+
+using AverageValueSpans_u8_f32 = AverageValueSpans<uint8_t, float>;
+HALIDE_REGISTER_GENERATOR(AverageValueSpans_u8_f32, average_value_spans_u8_f32);
+using AverageValueSpans_u16_f32 = AverageValueSpans<uint16_t, float>;
+HALIDE_REGISTER_GENERATOR(AverageValueSpans_u16_f32, average_value_spans_u16_f32);
+using AverageValueSpans_u8_f64 = AverageValueSpans<uint8_t, double>;
+HALIDE_REGISTER_GENERATOR(AverageValueSpans_u8_f64, average_value_spans_u8_f64);
+using AverageValueSpans_u16_f64 = AverageValueSpans<uint16_t, double>;
+HALIDE_REGISTER_GENERATOR(AverageValueSpans_u16_f64, average_value_spans_u16_f64);
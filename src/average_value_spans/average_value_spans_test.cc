@@ -0,0 +1,102 @@
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "average_value_spans_u8_f32.h"
+#include "average_value_spans_u16_f32.h"
+#include "average_value_spans_u8_f64.h"
+#include "average_value_spans_u16_f64.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+template <typename S, typename D>
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_spans_buffer, int32_t _num_spans,
+                     struct halide_buffer_t *_dst_buffer))
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<S>(extents);
+        auto output = mk_null_buffer<D>({1});
+
+        const int32_t max_spans = 1024;
+        auto spans_buffer = mk_null_buffer<int32_t>({3, max_spans});
+
+        // Disk of radius 40 at the center, about 0.6% of the frame
+        std::vector<std::array<int32_t, 3>> disk;
+        for (int y=height/2-40; y<=height/2+40; ++y) {
+            const int32_t dx = static_cast<int32_t>(std::sqrt(40.0 * 40.0 - (y - height/2) * (y - height/2)));
+            disk.push_back({width/2 - dx, y, 2 * dx + 1});
+        }
+        // Spans along the edges of the frame, two of which stick out of it
+        std::vector<std::array<int32_t, 3>> edge{
+            {0, 0, 64}, {width - 64, 0, 64}, {0, height - 1, width}, {-8, height / 3, 24}, {width - 16, height / 2, 64}
+        };
+        // No span at all
+        std::vector<std::array<int32_t, 3>> none;
+
+        const std::vector<std::vector<std::array<int32_t, 3>>> cases{disk, edge, none};
+        for (size_t n=0; n<cases.size(); ++n) {
+            const std::vector<std::array<int32_t, 3>>& spans = cases[n];
+            const int32_t num_spans = static_cast<int32_t>(spans.size());
+            for (int i=0; i<num_spans; ++i) {
+                for (int c=0; c<3; ++c) {
+                    spans_buffer(c, i) = spans[i][c];
+                }
+            }
+
+            func(input, spans_buffer, num_spans, output);
+            if (n == 0) {
+                bench(func, input, spans_buffer, num_spans, output);
+            }
+
+            double sum = 0;
+            int count = 0;
+            for (auto& span : spans) {
+                const int y = span[1];
+                for (int x=span[0]; x<span[0]+span[2]; ++x) {
+                    if (x < 0 || x >= width || y < 0 || y >= height) {
+                        continue;
+                    }
+                    sum += input(x, y);
+                    count++;
+                }
+            }
+            const D expect = count == 0 ? 0 : static_cast<D>(sum / count);
+            const D actual = output(0);
+            if (expect != actual) {
+                throw std::runtime_error(format("Error: case %zu, expect = %f, actual = %f", n, expect, actual));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main()
+{
+#ifdef TYPE_u8_f32
+    test<uint8_t, float>(average_value_spans_u8_f32);
+#endif
+#ifdef TYPE_u16_f32
+    test<uint16_t, float>(average_value_spans_u16_f32);
+#endif
+#ifdef TYPE_u8_f64
+    test<uint8_t, double>(average_value_spans_u8_f64);
+#endif
+#ifdef TYPE_u16_f64
+    test<uint16_t, double>(average_value_spans_u16_f64);
+#endif
+}
@@ -4,9 +4,10 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
-template<typename T>
-class Bilateral : public Halide::Generator<Bilateral<T>> {
+template<typename T, Element::BilateralAlgorithm A = Element::BilateralAlgorithm::Direct>
+class Bilateral : public Halide::Generator<Bilateral<T, A>> {
 public:
     ImageParam src{type_of<T>(), 2, "src"};
     Param<int32_t> window_size{"window_size", 1};
@@ -16,17 +17,28 @@ public:
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::BilateralAlgorithm> algorithm{"algorithm", A, Element::bilateral_algorithm_enum_map};
 
     Func build() {
         Func dst{"dst"};
-        dst = Element::bilateral<T>(src, width, height, window_size, sigma_color, sigma_space);
+        dst = Element::bilateral<T>(src, width, height, window_size, sigma_color, sigma_space, algorithm, this->get_target());
 
-        window_size.set_range(1, 7);
+        if (algorithm == Element::BilateralAlgorithm::Direct) {
+            window_size.set_range(1, 7);
+        }
         schedule(src, {width, height});
         schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
         return dst;
     }
 };
 
 HALIDE_REGISTER_GENERATOR(Bilateral<uint8_t>, bilateral_u8);
 HALIDE_REGISTER_GENERATOR(Bilateral<uint16_t>, bilateral_u16);
+using Bilateral_u8_grid = Bilateral<uint8_t, Element::BilateralAlgorithm::Grid>;
+HALIDE_REGISTER_GENERATOR(Bilateral_u8_grid, bilateral_u8_grid);
+using Bilateral_u16_grid = Bilateral<uint16_t, Element::BilateralAlgorithm::Grid>;
+HALIDE_REGISTER_GENERATOR(Bilateral_u16_grid, bilateral_u16_grid);
+using Bilateral_u16_lut = Bilateral<uint16_t, Element::BilateralAlgorithm::Lut>;
+HALIDE_REGISTER_GENERATOR(Bilateral_u16_lut, bilateral_u16_lut);
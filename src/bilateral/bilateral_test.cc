@@ -6,9 +6,13 @@
 #include "HalideRuntime.h"
 #include "HalideBuffer.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 #include "bilateral_u8.h"
 #include "bilateral_u16.h"
+#include "bilateral_u8_grid.h"
+#include "bilateral_u16_grid.h"
+#include "bilateral_u16_lut.h"
 
 #define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
 
@@ -101,26 +105,28 @@ Halide::Runtime::Buffer<T>& bilateral_ref(Halide::Runtime::Buffer<T>& dst,
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src_buffer,
                      int32_t _window_size, double _color, double _space,
-                     struct halide_buffer_t *_dst_buffer))
+                     struct halide_buffer_t *_dst_buffer),
+         const int32_t window_size = 5,
+         const double sigma_color = 2.0,
+         const double sigma_space = mk_rand_scalar<double>(),
+         const int tolerance = 0)
 {
     try {
         const int width = 1024;
         const int height = 768;
         const std::vector<int32_t> extents{width, height};
-        const int32_t window_size = 5;
-        const double sigma_color = 2.0;
-        const double sigma_space = mk_rand_scalar<double>();
         auto input = mk_rand_buffer<T>(extents);
         auto output = mk_null_buffer<T>(extents);
 
         func(input, window_size, sigma_color, sigma_space, output);
+        bench(func, input, window_size, sigma_color, sigma_space, output);
 
         auto expect = mk_null_buffer<T>(extents);
         expect = bilateral_ref(expect, input, width, height, window_size, sigma_color, sigma_space);
         // for each x and y
         for (int j=0; j<width; ++j) {
             for (int i=0; i<height; ++i) {
-                if (abs(expect(j, i) - output(j, i)) > 0) {
+                if (abs(expect(j, i) - output(j, i)) > tolerance) {
                     throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d",
                                                 j, i, expect(j, i), j, i, output(j, i)));
                 }
@@ -143,5 +149,20 @@ int main()
 #endif
 #ifdef TYPE_u16
     test<uint16_t>(bilateral_u16);
+#endif
+    // Interpolated range kernel in float may flip rounding of the exact result.
+#ifdef TYPE_u16_lut
+    test<uint16_t>(bilateral_u16_lut, 5, 2.0, mk_rand_scalar<double>(), 1);
+    test<uint16_t>(bilateral_u16_lut, 5, 4096.0, mk_rand_scalar<double>(), 1);
+#endif
+    // Bilateral grid approximates the Gaussian spatial kernel, which is compared with a window of +-2 sigma.
+    // The approximation error on random input is within 5% of the range.
+#ifdef TYPE_u8_grid
+    test<uint8_t>(bilateral_u8_grid, 17, std::numeric_limits<uint8_t>::max() / 16.0, 4.0,
+                  std::numeric_limits<uint8_t>::max() / 20);
+#endif
+#ifdef TYPE_u16_grid
+    test<uint16_t>(bilateral_u16_grid, 17, std::numeric_limits<uint16_t>::max() / 16.0, 4.0,
+                   std::numeric_limits<uint16_t>::max() / 20);
 #endif
 }
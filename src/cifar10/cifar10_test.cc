@@ -9,6 +9,7 @@
 #include "HalideBuffer.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 #include "cifar10.h"
 
@@ -88,6 +89,7 @@ int main(int argc, char **argv) {
         Buffer<float> out(classes, batch_size);
 
         cifar10(in, out);
+        bench(cifar10, in, out);
 
         Buffer<int64_t> labels = load_data<int64_t>("data/test_label.bin");
 
@@ -0,0 +1,32 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+
+class Clahe : public Halide::Generator<Clahe> {
+public:
+    ImageParam src{UInt(8), 2, "src"};
+    Param<float> clip_limit{"clip_limit", 2.0f};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<int32_t> tiles_x{"tiles_x", 8};
+    GeneratorParam<int32_t> tiles_y{"tiles_y", 8};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+
+    Func build() {
+        Func dst{"dst"};
+        dst = Element::clahe(src, width, height, tiles_x, tiles_y, clip_limit);
+
+        schedule(src, {width, height});
+        schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(Clahe, clahe)
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "clahe.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+int main()
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const int tiles_x = 8;
+        const int tiles_y = 8;
+        const float clip_limit = 2.0f;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<uint8_t>(extents);
+        // Horizontal gradient with noise, so that tiles have different histograms
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                input(x, y) = static_cast<uint8_t>(x * 192 / width + input(x, y) / 4);
+            }
+        }
+        auto output = mk_null_buffer<uint8_t>(extents);
+
+        clahe(input, clip_limit, output);
+        bench(clahe, input, clip_limit, output);
+
+        // Reference of OpenCV's CLAHE
+        const int tile_width = width / tiles_x;
+        const int tile_height = height / tiles_y;
+        const int area = tile_width * tile_height;
+        const int clip = std::max(static_cast<int>(clip_limit * area / 256), 1);
+        const float lut_scale = 255.0f / area;
+        std::vector<uint8_t> lut(256 * tiles_x * tiles_y);
+        for (int ty=0; ty<tiles_y; ++ty) {
+            for (int tx=0; tx<tiles_x; ++tx) {
+                int hist[256] = {0};
+                for (int y=0; y<tile_height; ++y) {
+                    for (int x=0; x<tile_width; ++x) {
+                        hist[input(tx * tile_width + x, ty * tile_height + y)]++;
+                    }
+                }
+                int excess = 0;
+                for (int i=0; i<256; ++i) {
+                    if (hist[i] > clip) {
+                        excess += hist[i] - clip;
+                        hist[i] = clip;
+                    }
+                }
+                const int batch = excess / 256;
+                int residual = excess - batch * 256;
+                for (int i=0; i<256; ++i) {
+                    hist[i] += batch;
+                }
+                if (residual != 0) {
+                    const int step = std::max(256 / residual, 1);
+                    for (int i=0; i<256 && residual>0; i+=step, residual--) {
+                        hist[i]++;
+                    }
+                }
+                int sum = 0;
+                for (int i=0; i<256; ++i) {
+                    sum += hist[i];
+                    lut[(ty * tiles_x + tx) * 256 + i] = static_cast<uint8_t>(std::min(std::max(std::nearbyint(sum * lut_scale), 0.0f), 255.0f));
+                }
+            }
+        }
+
+        auto at = [&](int v, int tx, int ty) { return static_cast<float>(lut[(ty * tiles_x + tx) * 256 + v]); };
+        for (int y=0; y<height; ++y) {
+            const float tyf = y * (1.0f / tile_height) - 0.5f;
+            int ty1 = static_cast<int>(std::floor(tyf));
+            const float ya = tyf - ty1;
+            const int ty2 = std::min(ty1 + 1, tiles_y - 1);
+            ty1 = std::max(ty1, 0);
+            for (int x=0; x<width; ++x) {
+                const float txf = x * (1.0f / tile_width) - 0.5f;
+                int tx1 = static_cast<int>(std::floor(txf));
+                const float xa = txf - tx1;
+                const int tx2 = std::min(tx1 + 1, tiles_x - 1);
+                tx1 = std::max(tx1, 0);
+
+                const int v = input(x, y);
+                const float res = (at(v, tx1, ty1) * (1.0f - xa) + at(v, tx2, ty1) * xa) * (1.0f - ya)
+                                + (at(v, tx1, ty2) * (1.0f - xa) + at(v, tx2, ty2) * xa) * ya;
+                const int expect = static_cast<int>(std::min(std::max(std::nearbyint(res), 0.0f), 255.0f));
+                const int actual = output(x, y);
+                // Blending in float may flip rounding
+                if (abs(expect - actual) > 1) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d",
+                                                    x, y, expect, x, y, actual).c_str());
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
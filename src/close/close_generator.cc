@@ -5,6 +5,8 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
 template<typename T>
 class Close : public Halide::Generator<Close<T>> {
@@ -17,17 +19,29 @@ public:
     GeneratorParam<int32_t> iteration{"iteration", 2};
     GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
     GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", Element::MorphologyAlgorithm::Direct, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
     Func build() {
         Func erode{"erode"}, dilate{"dilate"};
+        Element::MorphologyStages stages;
 
-        dilate = Element::dilate<T>(input, width, height, window_width, window_height, structure, iteration);
-        erode = Element::erode<T>(dilate, width, height, window_width, window_height, structure, iteration);
+        dilate = Element::dilate<T>(input, width, height, window_width, window_height, structure, iteration, algorithm, fuse_iterations ? &stages : nullptr, this->get_target());
+        erode = Element::erode<T>(dilate, width, height, window_width, window_height, structure, iteration, algorithm, fuse_iterations ? &stages : nullptr, this->get_target());
 
         schedule(input, {width, height});
         schedule(structure, {window_width, window_height});
-        schedule(dilate, {width, height});
-        schedule(erode, {width, height});
+        if (fuse_iterations) {
+            stages.push_back(dilate);
+            schedule(erode, {width, height});
+            schedule_fused(erode, stages, {width, height}, cpu_schedule, this->get_target());
+        } else {
+            schedule(dilate, {width, height});
+            schedule_cpu(dilate, {width, height}, cpu_schedule, this->get_target());
+            schedule(erode, {width, height});
+            schedule_cpu(erode, {width, height}, cpu_schedule, this->get_target());
+        }
 
         return erode;
     }
@@ -11,6 +11,7 @@
 #include "close_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 
 // returns index of result workbuf
@@ -89,6 +90,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         expect = &(workbuf[k%2]);
 
         func(input, structure, output);
+        bench(func, input, structure, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
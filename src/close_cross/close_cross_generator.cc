@@ -5,6 +5,8 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
 template<typename T>
 class CloseCross : public Halide::Generator<CloseCross<T>> {
@@ -16,19 +18,31 @@ public:
     GeneratorParam<int32_t> iteration{"iteration", 2};
     GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
     GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", Element::MorphologyAlgorithm::Direct, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
 	Func build() {
 		Func dilate_cross{"dilate_cross"}, erode_cross{"erode_cross"};
+		Element::MorphologyStages stages;
 
 		// Run dilate
-		dilate_cross = Element::dilate_cross<T>(input, width, height, window_width, window_height, iteration);
+		dilate_cross = Element::dilate_cross<T>(input, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr);
 
 		// Run erode
-		erode_cross = Element::erode_cross<T>(dilate_cross, width, height, window_width, window_height, iteration);
+		erode_cross = Element::erode_cross<T>(dilate_cross, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr);
 
 		schedule(input, {width, height});
-		schedule(dilate_cross, {width, height});
-		schedule(erode_cross, {width, height});
+		if (fuse_iterations) {
+			stages.push_back(dilate_cross);
+			schedule(erode_cross, {width, height});
+			schedule_fused(erode_cross, stages, {width, height}, cpu_schedule, this->get_target());
+		} else {
+			schedule(dilate_cross, {width, height});
+			schedule_cpu(dilate_cross, {width, height}, cpu_schedule, this->get_target());
+			schedule(erode_cross, {width, height});
+			schedule_cpu(erode_cross, {width, height}, cpu_schedule, this->get_target());
+		}
 
 		return erode_cross;
 	}
@@ -5,6 +5,8 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
 template<typename T>
 class CloseRect : public Halide::Generator<CloseRect<T>> {
@@ -16,19 +18,31 @@ public:
     GeneratorParam<int32_t> iteration{"iteration", 2};
     GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
     GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", Element::MorphologyAlgorithm::Direct, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
 	Func build() {
 		Func dilate_rect{"dilate_rect"}, erode_rect{"erode_rect"};
+		Element::MorphologyStages stages;
 
 		// Run dilate
-		dilate_rect = Element::dilate_rect<T>(input, width, height, window_width, window_height, iteration);
+		dilate_rect = Element::dilate_rect<T>(input, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr, this->get_target());
 
 		// Run erode
-		erode_rect = Element::erode_rect<T>(dilate_rect, width, height, window_width, window_height, iteration);
+		erode_rect = Element::erode_rect<T>(dilate_rect, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr, this->get_target());
 
 		schedule(input, {width, height});
-		schedule(dilate_rect, {width, height});
-		schedule(erode_rect, {width, height});
+		if (fuse_iterations) {
+			stages.push_back(dilate_rect);
+			schedule(erode_rect, {width, height});
+			schedule_fused(erode_rect, stages, {width, height}, cpu_schedule, this->get_target());
+		} else {
+			schedule(dilate_rect, {width, height});
+			schedule_cpu(dilate_rect, {width, height}, cpu_schedule, this->get_target());
+			schedule(erode_rect, {width, height});
+			schedule_cpu(erode_rect, {width, height}, cpu_schedule, this->get_target());
+		}
 
 		return erode_rect;
 	}
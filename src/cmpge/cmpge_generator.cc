@@ -5,6 +5,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class Cmpge : public Halide::Generator<Cmpge<T>> {
@@ -14,6 +15,7 @@ public:
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Func build() {
         Func dst{"dst"};
@@ -23,6 +25,7 @@ public:
         schedule(src0, {width, height});
         schedule(src1, {width, height});
         schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
 
         return dst;
     }
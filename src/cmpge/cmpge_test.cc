@@ -12,6 +12,7 @@
 #include "cmpge_u32.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src0_buffer, struct halide_buffer_t *_src1_buffer, struct halide_buffer_t *_dst_buffer))
@@ -30,6 +31,7 @@ int test(int (*func)(struct halide_buffer_t *_src0_buffer, struct halide_buffer_
         auto output = mk_null_buffer<T>(extents);
 
         func(input0, input1, output);
+        bench(func, input0, input1, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
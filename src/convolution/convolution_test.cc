@@ -5,35 +5,41 @@
 #include "HalideRuntime.h"
 #include "HalideBuffer.h"
 
-#include "convolution.h"
+#include "convolution_u8.h"
+#include "convolution_u8_7x7.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace Halide::Runtime;
 
-int main(int argc, char **argv) {
+#define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
+
+int test(int (*func)(struct halide_buffer_t *_in_buffer, struct halide_buffer_t *_kernel_buffer, int32_t _kernel_size,
+                     struct halide_buffer_t *_out_buffer), const int max_kernel_size)
+{
     try {
 
         const int width = 512;
         const int height = 512;
         Buffer<uint8_t> input = mk_const_buffer<uint8_t>({width, height}, 1);
-                
+
         using fixed16_t = int16_t;
         constexpr uint32_t frac_bits = 10;
         const fixed16_t kv = static_cast<fixed16_t>(round(1.0f * (1 << frac_bits)));
-        fixed16_t kernel_data[5][5] = {
-            { kv, kv, kv, 0, 0},
-            { kv, kv, kv, 0, 0},
-            { kv, kv, kv, 0, 0},
-            { 0,  0,  0,  0, 0},
-            { 0,  0,  0,  0, 0}
-        };
 
-        Buffer<fixed16_t> kernel(reinterpret_cast<fixed16_t*>(kernel_data), 5, 5);
+        // 3x3 kernel at the top left of the kernel buffer
+        Buffer<fixed16_t> kernel = mk_const_buffer<fixed16_t>({max_kernel_size, max_kernel_size}, 0);
+        for (int y=0; y<3; ++y) {
+            for (int x=0; x<3; ++x) {
+                kernel(x, y) = kv;
+            }
+        }
 
         Buffer<uint8_t> output(width, height);
 
-        convolution(input, kernel, 3, output);
+        func(input, kernel, 3, output);
+        bench(func, input, kernel, 3, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -45,6 +51,42 @@ int main(int argc, char **argv) {
             }
         }
 
+        // Kernel of the largest size with taps only on its corners and center, so that a smaller window gives a different result.
+        // Pixels are kept small enough not to overflow Fixed<16, 10>.
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                input(x, y) = static_cast<uint8_t>(rand() % 7);
+            }
+        }
+        for (int y=0; y<max_kernel_size; ++y) {
+            for (int x=0; x<max_kernel_size; ++x) {
+                bool corner = (x == 0 || x == max_kernel_size - 1) && (y == 0 || y == max_kernel_size - 1);
+                bool center = x == max_kernel_size / 2 && y == max_kernel_size / 2;
+                kernel(x, y) = (corner || center) ? kv : 0;
+            }
+        }
+
+        func(input, kernel, max_kernel_size, output);
+
+        const int kh = max_kernel_size / 2;
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                int s = 0;
+                for (int ry=-kh; ry<=kh; ry++) {
+                    for (int rx=-kh; rx<=kh; rx++) {
+                        if (kernel(rx + kh, ry + kh) != 0) {
+                            s += input(BORDER_INTERPOLATE(x + rx, width), BORDER_INTERPOLATE(y + ry, height));
+                        }
+                    }
+                }
+                uint8_t ev = s;
+                uint8_t av = output(x, y);
+                if (ev != av) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d", x, y, ev, x, y, av).c_str());
+                }
+            }
+        }
+
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
         return 1;
@@ -53,3 +95,13 @@ int main(int argc, char **argv) {
     printf("Success!\n");
     return 0;
 }
+
+int main(int argc, char **argv)
+{
+#ifdef TYPE_u8
+    test(convolution_u8, 5);
+#endif
+#ifdef TYPE_u8_7x7
+    test(convolution_u8_7x7, 7);
+#endif
+}
@@ -5,8 +5,11 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::specialize_convolution;
 
-class Convolution : public Halide::Generator<Convolution> {
+template<int32_t K = 5>
+class Convolution : public Halide::Generator<Convolution<K>> {
     static constexpr uint32_t NB = 20;
     static constexpr uint32_t FB = 10;
     static constexpr uint32_t UB = 32;
@@ -17,28 +20,38 @@ class Convolution : public Halide::Generator<Convolution> {
 #else
     ImageParam kernel{Int(UB), 2, "kernel"};
 #endif
-    Param<int32_t> kernel_size{"kernel_size", 3, 1, 5};
+    Param<int32_t> kernel_size{"kernel_size", 3, 1, K};
 
     GeneratorParam<int32_t> width{"width", 512};
     GeneratorParam<int32_t> height{"height", 512};
+    GeneratorParam<int32_t> max_kernel_size{"max_kernel_size", K};
     GeneratorParam<int32_t> unroll_factor{"unroll_factor", 2};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
 public:
     Func build() {
         Func out{"out"};
 
-        out = Element::convolution<NB, FB>(in, width, height, kernel, kernel_size.get(), unroll_factor);
+        kernel_size.set_range(1, max_kernel_size);
+
+        out = Element::convolution<NB, FB>(in, width, height, kernel, kernel_size, max_kernel_size, unroll_factor);
 
         schedule(in, {width, height});
-        schedule(kernel, {5, 5});
+        schedule(kernel, {max_kernel_size, max_kernel_size});
         schedule(out, {width, height});
+        schedule_cpu(out, {width, height}, cpu_schedule, this->get_target());
 
         if (unroll_factor) {
             out.unroll(out.args()[0], unroll_factor);
         }
+        specialize_convolution(out, kernel_size, max_kernel_size);
 
         return out;
     }
 };
 
-HALIDE_REGISTER_GENERATOR(Convolution, convolution_arbitrary_bits)
+using Convolution_u8 = Convolution<>;
+HALIDE_REGISTER_GENERATOR(Convolution_u8, convolution_arbitrary_bits_u8);
+// Kernels up to 7x7, which take a 7x7 kernel buffer
+using Convolution_u8_7x7 = Convolution<7>;
+HALIDE_REGISTER_GENERATOR(Convolution_u8_7x7, convolution_arbitrary_bits_u8_7x7);
@@ -5,15 +5,19 @@
 #include "HalideRuntime.h"
 #include "HalideBuffer.h"
 
-#include "convolution_arbitrary_bits.h"
+#include "convolution_arbitrary_bits_u8.h"
+#include "convolution_arbitrary_bits_u8_7x7.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace Halide::Runtime;
 
 #define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
 
-int main(int argc, char **argv) {
+int test(int (*func)(struct halide_buffer_t *_in_buffer, struct halide_buffer_t *_kernel_buffer, int32_t _kernel_size,
+                     struct halide_buffer_t *_out_buffer), const int max_kernel_size)
+{
     try {
 
         const int width = 512;
@@ -24,43 +28,64 @@ int main(int argc, char **argv) {
         constexpr uint32_t frac_bits = 10;
         constexpr uint32_t base_bits = 20;
         const fixed20_t kv = static_cast<fixed20_t>(round(1.0 / 9.0 * (1 << frac_bits)));
-        fixed20_t kernel_data[5][5] = {
-            { kv, kv, kv, 0, 0},
-            { kv, kv, kv, 0, 0},
-            { kv, kv, kv, 0, 0},
-            { 0,  0,  0,  0, 0},
-            { 0,  0,  0,  0, 0}
-        };
 
-        Buffer<fixed20_t> kernel(reinterpret_cast<fixed20_t*>(kernel_data), 5, 5);
+        // 3x3 kernel at the top left of the kernel buffer
+        Buffer<fixed20_t> kernel = mk_const_buffer<fixed20_t>({max_kernel_size, max_kernel_size}, 0);
+        for (int y=0; y<3; ++y) {
+            for (int x=0; x<3; ++x) {
+                kernel(x, y) = kv;
+            }
+        }
 
         Buffer<uint8_t> output(width, height);
 
-        convolution_arbitrary_bits(input, kernel, 3, output);
+        auto check = [&](int kernel_size) {
+            const int kh = kernel_size / 2;
+            for (int y=0; y<height; ++y) {
+                for (int x=0; x<width; ++x) {
+                    fixed20_t s = 0;
+                    for (int ry=-kh; ry<=kh; ry++) {
+                        for (int rx=-kh; rx<=kh; rx++) {
+                            int cx = BORDER_INTERPOLATE(x + rx, width);
+                            int cy = BORDER_INTERPOLATE(y + ry, height);
+                            // Simulate add & mult of Fixed<base_bits, frac_bits>
+                            s += ((kernel(rx + kh, ry + kh) * (input(cx, cy) << frac_bits)) >> frac_bits);
+                            // Bitmask for simulating overflow
+                            s = s & ((1 << base_bits) - 1);
+                            // Sign extension
+                            s = s << (base_bits - frac_bits) >> (base_bits - frac_bits);
+                        }
+                    }
+                    uint8_t ev = s >> frac_bits;
+                    uint8_t av = output(x, y);
+                    if (ev != av) {
+                        throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d", x, y, ev, x, y, av).c_str());
+                    }
+                }
+            }
+        };
+
+        func(input, kernel, 3, output);
+        bench(func, input, kernel, 3, output);
+        check(3);
 
+        // Kernel of the largest size with taps only on its corners and center, so that a smaller window gives a different result
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
-                fixed20_t s = 0;
-                for (int ry=-1; ry<=1; ry++) {
-                    for (int rx=-1; rx<=1; rx++) {
-                        int cx = BORDER_INTERPOLATE(x + rx, width);
-                        int cy = BORDER_INTERPOLATE(y + ry, height);
-                        // Simulate add & mult of Fixed<base_bits, frac_bits>
-                        s += ((kernel(rx + 1, ry + 1) * (input(cx, cy) << frac_bits)) >> frac_bits);
-                        // Bitmask for simulating overflow
-                        s = s & ((1 << base_bits) - 1);
-                        // Sign extension
-                        s = s << (base_bits - frac_bits) >> (base_bits - frac_bits);
-                    }
-                }
-                uint8_t ev = s >> frac_bits;
-                uint8_t av = output(x, y);
-                if (ev != av) {
-                    throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d", x, y, ev, x, y, av).c_str());
-                }
+                input(x, y) = static_cast<uint8_t>(rand() % 7);
+            }
+        }
+        for (int y=0; y<max_kernel_size; ++y) {
+            for (int x=0; x<max_kernel_size; ++x) {
+                bool corner = (x == 0 || x == max_kernel_size - 1) && (y == 0 || y == max_kernel_size - 1);
+                bool center = x == max_kernel_size / 2 && y == max_kernel_size / 2;
+                kernel(x, y) = (corner || center) ? (1 << frac_bits) : 0;
             }
         }
 
+        func(input, kernel, max_kernel_size, output);
+        check(max_kernel_size);
+
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
         return 1;
@@ -69,3 +94,13 @@ int main(int argc, char **argv) {
     printf("Success!\n");
     return 0;
 }
+
+int main(int argc, char **argv)
+{
+#ifdef TYPE_u8
+    test(convolution_arbitrary_bits_u8, 5);
+#endif
+#ifdef TYPE_u8_7x7
+    test(convolution_arbitrary_bits_u8_7x7, 7);
+#endif
+}
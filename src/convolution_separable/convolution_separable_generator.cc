@@ -0,0 +1,39 @@
+#include <cstdint>
+
+#include <Halide.h>
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+
+class ConvolutionSeparable : public Halide::Generator<ConvolutionSeparable> {
+    static constexpr uint32_t NB = 32;
+    static constexpr uint32_t FB = 10;
+
+    ImageParam in{UInt(8), 2, "in"};
+    ImageParam kernel_x{Int(NB), 1, "kernel_x"};
+    ImageParam kernel_y{Int(NB), 1, "kernel_y"};
+
+    GeneratorParam<int32_t> width{"width", 512};
+    GeneratorParam<int32_t> height{"height", 512};
+    GeneratorParam<int32_t> kernel_size{"kernel_size", 7};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+
+public:
+    Func build() {
+        Func out{"out"};
+
+        out = Element::convolution_separable<NB, FB>(in, width, height, kernel_x, kernel_y, kernel_size);
+
+        schedule(in, {width, height});
+        schedule(kernel_x, {kernel_size});
+        schedule(kernel_y, {kernel_size});
+        schedule(out, {width, height});
+        schedule_cpu(out, {width, height}, cpu_schedule, this->get_target());
+
+        return out;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(ConvolutionSeparable, convolution_separable)
@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <iostream>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "convolution_separable.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+using namespace Halide::Runtime;
+
+#define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
+
+int main(int argc, char **argv) {
+    try {
+
+        const int width = 512;
+        const int height = 512;
+        const int kernel_size = 7;
+        const int kh = kernel_size / 2;
+        Buffer<uint8_t> input = mk_rand_buffer<uint8_t>({width, height});
+
+        using fixed32_t = int32_t;
+        constexpr uint32_t frac_bits = 10;
+        // Binomial kernel, which sums up to 1.0
+        fixed32_t kernel_data[kernel_size] = {16, 96, 240, 320, 240, 96, 16};
+
+        Buffer<fixed32_t> kernel_x(kernel_data, kernel_size);
+        Buffer<fixed32_t> kernel_y(kernel_data, kernel_size);
+
+        Buffer<uint8_t> output(width, height);
+
+        convolution_separable(input, kernel_x, kernel_y, output);
+        bench(convolution_separable, input, kernel_x, kernel_y, output);
+
+        // Row pass is exact, and column pass is normalized once
+        std::vector<int64_t> rows(width * height);
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                int64_t s = 0;
+                for (int r=0; r<kernel_size; ++r) {
+                    s += static_cast<int64_t>(kernel_x(r)) * input(BORDER_INTERPOLATE(x + r - kh, width), y);
+                }
+                rows[y * width + x] = s;
+            }
+        }
+
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                int64_t s = 0;
+                for (int r=0; r<kernel_size; ++r) {
+                    s += kernel_y(r) * rows[BORDER_INTERPOLATE(y + r - kh, height) * width + x];
+                }
+                uint8_t ev = static_cast<uint8_t>((s >> frac_bits) >> frac_bits);
+                uint8_t av = output(x, y);
+                if (ev != av) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d", x, y, ev, x, y, av).c_str());
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <cstdint>
+
+#include <Halide.h>
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<bool W = true>
+class ConvolutionWinograd : public Halide::Generator<ConvolutionWinograd<W>> {
+    static constexpr uint32_t FB = 10;
+
+    ImageParam in{UInt(8), 2, "in"};
+    ImageParam kernel{Int(32), 2, "kernel"};
+
+    GeneratorParam<int32_t> width{"width", 512};
+    GeneratorParam<int32_t> height{"height", 512};
+    GeneratorParam<bool> winograd{"winograd", W};
+
+public:
+    Func build() {
+        Func out{"out"};
+
+        if (winograd) {
+            out = Element::convolution_winograd<FB>(in, width, height, kernel);
+        } else {
+            // Direct 3x3 convolution in Fixed<32, FB>, which gives the same result
+            out = Element::convolution<32, FB>(in, width, height, kernel, 3, 3, 0);
+        }
+
+        schedule(in, {width, height});
+        schedule(kernel, {3, 3});
+        schedule(out, {width, height});
+
+        return out;
+    }
+};
+
+using ConvolutionWinograd_u8 = ConvolutionWinograd<>;
+HALIDE_REGISTER_GENERATOR(ConvolutionWinograd_u8, convolution_winograd_u8);
+// Reference by the convolution element
+using ConvolutionWinograd_u8_direct = ConvolutionWinograd<false>;
+HALIDE_REGISTER_GENERATOR(ConvolutionWinograd_u8_direct, convolution_winograd_u8_direct);
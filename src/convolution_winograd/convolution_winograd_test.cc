@@ -0,0 +1,78 @@
+#include <cstdlib>
+#include <iostream>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "convolution_winograd_u8.h"
+#include "convolution_winograd_u8_direct.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+using namespace Halide::Runtime;
+
+using fixed32_t = int32_t;
+
+// Signed kernel, which also exercises wrap-around of the output
+fixed32_t kernel_data[3][3] = {
+    {  128,  -96,  200 },
+    { -320, 1024, -160 },
+    {   64, -256,  300 }
+};
+
+int test(int (*func)(struct halide_buffer_t *_in_buffer, struct halide_buffer_t *_kernel_buffer, struct halide_buffer_t *_out_buffer),
+         int (*reference)(struct halide_buffer_t *_in_buffer, struct halide_buffer_t *_kernel_buffer, struct halide_buffer_t *_out_buffer))
+{
+    try {
+
+        const int width = 512;
+        const int height = 512;
+        Buffer<uint8_t> input = mk_rand_buffer<uint8_t>({width, height});
+        Buffer<fixed32_t> kernel(reinterpret_cast<fixed32_t*>(kernel_data), 3, 3);
+
+        Buffer<uint8_t> output(width, height);
+        Buffer<uint8_t> expect(width, height);
+
+        func(input, kernel, output);
+        bench(func, input, kernel, output);
+
+        if (!reference) {
+            printf("Success!\n");
+            return 0;
+        }
+
+        // Winograd transform should give exactly the same result as direct convolution
+        reference(input, kernel, expect);
+
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                uint8_t ev = expect(x, y);
+                uint8_t av = output(x, y);
+                if (ev != av) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d", x, y, ev, x, y, av).c_str());
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+#if defined(TYPE_u8) && defined(TYPE_u8_direct)
+    test(convolution_winograd_u8, convolution_winograd_u8_direct);
+#elif defined(TYPE_u8)
+    test(convolution_winograd_u8, nullptr);
+#endif
+#ifdef TYPE_u8_direct
+    test(convolution_winograd_u8_direct, nullptr);
+#endif
+}
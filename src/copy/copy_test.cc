@@ -6,6 +6,7 @@
 #include "copy_u8.h"
 #include "copy_u16.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using std::string;
 using std::vector;
@@ -26,6 +27,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<T>(extents);
 
         func(input, output);
+        bench(func, input, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
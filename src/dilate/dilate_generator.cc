@@ -5,9 +5,11 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
-template<typename T>
-class Dilate : public Halide::Generator<Dilate<T>> {
+template<typename T, Element::MorphologyAlgorithm A = Element::MorphologyAlgorithm::Direct>
+class Dilate : public Halide::Generator<Dilate<T, A>> {
 public:
     ImageParam input{type_of<T>(), 2, "input"};
     ImageParam structure{UInt(8), 2, "structure"};
@@ -17,15 +19,24 @@ public:
     GeneratorParam<int32_t> iteration{"iteration", 2};
     GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
     GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", A, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
     Func build() {
         Func output{"output"};
+        Element::MorphologyStages stages;
 
-        output = Element::dilate<T>(input, width, height, window_width, window_height, structure, iteration);
+        output = Element::dilate<T>(input, width, height, window_width, window_height, structure, iteration, algorithm, fuse_iterations ? &stages : nullptr, this->get_target());
 
         schedule(input, {width, height});
         schedule(structure, {window_width, window_height});
         schedule(output, {width, height});
+        if (fuse_iterations) {
+            schedule_fused(output, stages, {width, height}, cpu_schedule, this->get_target());
+        } else {
+            schedule_cpu(output, {width, height}, cpu_schedule, this->get_target());
+        }
 
         return output;
     }
@@ -33,3 +44,5 @@ public:
 
 HALIDE_REGISTER_GENERATOR(Dilate<uint8_t>, dilate_u8);
 HALIDE_REGISTER_GENERATOR(Dilate<uint16_t>, dilate_u16);
+using Dilate_u8_decompose = Dilate<uint8_t, Element::MorphologyAlgorithm::Decomposed>;
+HALIDE_REGISTER_GENERATOR(Dilate_u8_decompose, dilate_u8_decompose);
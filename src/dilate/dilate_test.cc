@@ -9,8 +9,10 @@
 
 #include "dilate_u8.h"
 #include "dilate_u16.h"
+#include "dilate_u8_decompose.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_structure_buffer, struct halide_buffer_t *_workbuf__1_buffer))
@@ -71,6 +73,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         expect = &(workbuf[k%2]);
 
         func(input, structure, output);
+        bench(func, input, structure, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -98,4 +101,7 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(dilate_u16);
 #endif
+#ifdef TYPE_u8_decompose
+    test<uint8_t>(dilate_u8_decompose);
+#endif
 }
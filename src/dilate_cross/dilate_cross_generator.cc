@@ -5,9 +5,11 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
-template<typename T>
-class DilateCross : public Halide::Generator<DilateCross<T>> {
+template<typename T, Element::MorphologyAlgorithm A = Element::MorphologyAlgorithm::Direct>
+class DilateCross : public Halide::Generator<DilateCross<T, A>> {
 public:
     ImageParam input{type_of<T>(), 2, "input"};
 
@@ -16,14 +18,23 @@ public:
     GeneratorParam<int32_t> iteration{"iteration", 2};
     GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
     GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", A, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
     Func build() {
         Func output{"output"};
+        Element::MorphologyStages stages;
 
-        output = Element::dilate_cross<T>(input, width, height, window_width, window_height, iteration);
+        output = Element::dilate_cross<T>(input, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr);
 
         schedule(input, {width, height});
         schedule(output, {width, height});
+        if (fuse_iterations) {
+            schedule_fused(output, stages, {width, height}, cpu_schedule, this->get_target());
+        } else {
+            schedule_cpu(output, {width, height}, cpu_schedule, this->get_target());
+        }
 
         return output;
     }
@@ -31,3 +42,5 @@ public:
 
 HALIDE_REGISTER_GENERATOR(DilateCross<uint8_t>, dilate_cross_u8);
 HALIDE_REGISTER_GENERATOR(DilateCross<uint16_t>, dilate_cross_u16);
+using DilateCross_u8_binary = DilateCross<uint8_t, Element::MorphologyAlgorithm::Binary>;
+HALIDE_REGISTER_GENERATOR(DilateCross_u8_binary, dilate_cross_u8_binary);
@@ -0,0 +1,29 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+
+class EqualizeHist : public Halide::Generator<EqualizeHist> {
+public:
+    ImageParam src{UInt(8), 2, "src"};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+
+    Func build() {
+        Func dst{"dst"};
+        dst = Element::equalize_hist(src, width, height);
+
+        schedule(src, {width, height});
+        schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(EqualizeHist, equalize_hist)
@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "equalize_hist.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+int main()
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<uint8_t>(extents);
+        // Narrow the range so that equalization has an effect
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                input(x, y) = 64 + input(x, y) / 4;
+            }
+        }
+        auto output = mk_null_buffer<uint8_t>(extents);
+
+        equalize_hist(input, output);
+        bench(equalize_hist, input, output);
+
+        int64_t hist[256] = {0};
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                hist[input(x, y)]++;
+            }
+        }
+        const int64_t total = static_cast<int64_t>(width) * height;
+        int64_t cdf[256];
+        int64_t cdf_min = total;
+        for (int i=0; i<256; ++i) {
+            cdf[i] = (i > 0 ? cdf[i - 1] : 0) + hist[i];
+            if (hist[i] > 0 && cdf[i] < cdf_min) {
+                cdf_min = cdf[i];
+            }
+        }
+        const int64_t denom = total - cdf_min;
+        uint8_t lut[256];
+        for (int i=0; i<256; ++i) {
+            lut[i] = denom > 0 ? static_cast<uint8_t>((std::max<int64_t>(cdf[i] - cdf_min, 0) * 255 + denom / 2) / denom)
+                               : static_cast<uint8_t>(i);
+        }
+
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                uint8_t expect = lut[input(x, y)];
+                uint8_t actual = output(x, y);
+                if (expect != actual) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d",
+                                                    x, y, expect, x, y, actual).c_str());
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
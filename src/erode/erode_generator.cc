@@ -4,27 +4,38 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
-template<typename T>
-class Erode : public Halide::Generator<Erode<T>> {
+template<typename T, Element::MorphologyAlgorithm A = Element::MorphologyAlgorithm::Direct, int32_t W = 3, int32_t H = 3>
+class Erode : public Halide::Generator<Erode<T, A, W, H>> {
 public:
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
     GeneratorParam<int32_t> iteration{"iteration", 2};
     ImageParam src{type_of<T>(), 2, "src"};
     ImageParam structure{UInt(8), 2, "structure"};
-    GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
-    GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<int32_t> window_width{"window_width", W, 3, 17};
+    GeneratorParam<int32_t> window_height{"window_height", H, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", A, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
     Func build() {
         Var x{"x"}, y{"y"};
         Func dst("dst");
+        Element::MorphologyStages stages;
 
-        dst(x, y) = Element::erode<T>(src, width, height, window_width, window_height, structure, iteration)(x, y);
+        dst(x, y) = Element::erode<T>(src, width, height, window_width, window_height, structure, iteration, algorithm, fuse_iterations ? &stages : nullptr, this->get_target())(x, y);
 
         schedule(src, {width, height});
         schedule(structure, {window_width, window_height});
         schedule(dst, {width, height});
+        if (fuse_iterations) {
+            schedule_fused(dst, stages, {width, height}, cpu_schedule, this->get_target());
+        } else {
+            schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
+        }
 
         return dst;
     }
@@ -32,3 +43,7 @@ public:
 
 HALIDE_REGISTER_GENERATOR(Erode<uint8_t>, erode_u8);
 HALIDE_REGISTER_GENERATOR(Erode<uint16_t>, erode_u16);
+using Erode_u8_decompose = Erode<uint8_t, Element::MorphologyAlgorithm::Decomposed>;
+HALIDE_REGISTER_GENERATOR(Erode_u8_decompose, erode_u8_decompose);
+using Erode_u8_decompose15x9 = Erode<uint8_t, Element::MorphologyAlgorithm::Decomposed, 15, 9>;
+HALIDE_REGISTER_GENERATOR(Erode_u8_decompose15x9, erode_u8_decompose15x9);
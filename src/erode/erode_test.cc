@@ -9,11 +9,15 @@
 
 #include "erode_u8.h"
 #include "erode_u16.h"
+#include "erode_u8_decompose.h"
+#include "erode_u8_decompose15x9.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
-int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_structure_buffer, struct halide_buffer_t *_workbuf__1_buffer))
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_structure_buffer, struct halide_buffer_t *_workbuf__1_buffer),
+         const int window_width = 3, const int window_height = 3)
 {
     try {
         int ret = 0;
@@ -23,8 +27,6 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         //
         const int width = 1024;
         const int height = 768;
-        const int window_width = 3;
-        const int window_height = 3;
         const int iteration = 2;
         const std::vector<int32_t> extents{width, height}, extents_structure{window_width, window_height};
         auto input = mk_rand_buffer<T>(extents);
@@ -71,6 +73,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         expect = &(workbuf[k%2]);
 
         func(input, structure, output);
+        bench(func, input, structure, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -98,4 +101,10 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(erode_u16);
 #endif
+#ifdef TYPE_u8_decompose
+    test<uint8_t>(erode_u8_decompose);
+#endif
+#ifdef TYPE_u8_decompose15x9
+    test<uint8_t>(erode_u8_decompose15x9, 15, 9);
+#endif
 }
@@ -5,8 +5,8 @@
 using namespace Halide;
 using namespace Halide::Element;
 
-template<typename T>
-class ErodeCross : public Halide::Generator<ErodeCross<T>> {
+template<typename T, Element::MorphologyAlgorithm A = Element::MorphologyAlgorithm::Direct>
+class ErodeCross : public Halide::Generator<ErodeCross<T, A>> {
 public:
     ImageParam src{type_of<T>(), 2, "src"};
 
@@ -15,14 +15,23 @@ public:
     GeneratorParam<int32_t> iteration{"iteration", 2};
     GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
     GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", A, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
     Func build() {
         Func dst{"dst"};
+        Element::MorphologyStages stages;
 
-        dst = Element::erode_cross<T>(src, width, height, window_width, window_height, iteration);
+        dst = Element::erode_cross<T>(src, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr);
 
         schedule(src, {width, height});
         schedule(dst, {width, height});
+        if (fuse_iterations) {
+            schedule_fused(dst, stages, {width, height}, cpu_schedule, this->get_target());
+        } else {
+            schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
+        }
 
         return dst;
     }
@@ -30,3 +39,5 @@ public:
 
 HALIDE_REGISTER_GENERATOR(ErodeCross<uint8_t>, erode_cross_u8);
 HALIDE_REGISTER_GENERATOR(ErodeCross<uint16_t>, erode_cross_u16);
+using ErodeCross_u8_binary = ErodeCross<uint8_t, Element::MorphologyAlgorithm::Binary>;
+HALIDE_REGISTER_GENERATOR(ErodeCross_u8_binary, erode_cross_u8_binary);
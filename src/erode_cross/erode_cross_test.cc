@@ -9,11 +9,13 @@
 
 #include "erode_cross_u8.h"
 #include "erode_cross_u16.h"
+#include "erode_cross_u8_binary.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
-int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_workbuf__1_buffer))
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_workbuf__1_buffer), bool binary = false)
 {
     try {
         int ret = 0;
@@ -28,6 +30,14 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         const int iteration = 2;
         const std::vector<int32_t> extents{width, height};
         auto input = mk_rand_buffer<T>(extents);
+        if (binary) {
+            // 0/max mask
+            for (int y=0; y<height; ++y) {
+                for (int x=0; x<width; ++x) {
+                    input(x, y) = input(x, y) & 1 ? std::numeric_limits<T>::max() : 0;
+                }
+            }
+        }
         auto output = mk_null_buffer<T>(extents);
         T (*expect)[width][height], workbuf[2][width][height];
 
@@ -61,6 +71,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         expect = &(workbuf[k%2]);
 
         func(input, output);
+        bench(func, input, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -88,4 +99,7 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(erode_cross_u16);
 #endif
+#ifdef TYPE_u8_binary
+    test<uint8_t>(erode_cross_u8_binary, true);
+#endif
 }
@@ -4,25 +4,37 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
-template<typename T>
-class ErodeRect : public Halide::Generator<ErodeRect<T>> {
+template<typename T, Element::MorphologyAlgorithm A = Element::MorphologyAlgorithm::Direct, int32_t W = 3, int32_t H = 3,
+         bool F = false>
+class ErodeRect : public Halide::Generator<ErodeRect<T, A, W, H, F>> {
 public:
     ImageParam src{type_of<T>(), 2, "src"};
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
     GeneratorParam<int32_t> iteration{"iteration", 2};
-    GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
-    GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<int32_t> window_width{"window_width", W, 3, 17};
+    GeneratorParam<int32_t> window_height{"window_height", H, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", A, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", F};
 
     Func build() {
         Func dst{"dst"};
+        Element::MorphologyStages stages;
 
-        dst = Element::erode_rect<T>(src, width, height, window_width, window_height, iteration);
+        dst = Element::erode_rect<T>(src, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr, this->get_target());
 
         schedule(src, {width, height});
         schedule(dst, {width, height});
+        if (fuse_iterations) {
+            schedule_fused(dst, stages, {width, height}, cpu_schedule, this->get_target());
+        } else {
+            schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
+        }
 
         return dst;
     }
@@ -30,3 +42,15 @@ public:
 
 HALIDE_REGISTER_GENERATOR(ErodeRect<uint8_t>, erode_rect_u8);
 HALIDE_REGISTER_GENERATOR(ErodeRect<uint16_t>, erode_rect_u16);
+using ErodeRect_u8_vhgw = ErodeRect<uint8_t, Element::MorphologyAlgorithm::VanHerkGilWerman>;
+HALIDE_REGISTER_GENERATOR(ErodeRect_u8_vhgw, erode_rect_u8_vhgw);
+using ErodeRect_u16_vhgw = ErodeRect<uint16_t, Element::MorphologyAlgorithm::VanHerkGilWerman>;
+HALIDE_REGISTER_GENERATOR(ErodeRect_u16_vhgw, erode_rect_u16_vhgw);
+using ErodeRect_u8_binary = ErodeRect<uint8_t, Element::MorphologyAlgorithm::Binary>;
+HALIDE_REGISTER_GENERATOR(ErodeRect_u8_binary, erode_rect_u8_binary);
+using ErodeRect_u8_vhgw15x9 = ErodeRect<uint8_t, Element::MorphologyAlgorithm::VanHerkGilWerman, 15, 9>;
+HALIDE_REGISTER_GENERATOR(ErodeRect_u8_vhgw15x9, erode_rect_u8_vhgw15x9);
+using ErodeRect_u8_binary15x9 = ErodeRect<uint8_t, Element::MorphologyAlgorithm::Binary, 15, 9>;
+HALIDE_REGISTER_GENERATOR(ErodeRect_u8_binary15x9, erode_rect_u8_binary15x9);
+using ErodeRect_u8_fused = ErodeRect<uint8_t, Element::MorphologyAlgorithm::Direct, 3, 3, true>;
+HALIDE_REGISTER_GENERATOR(ErodeRect_u8_fused, erode_rect_u8_fused);
@@ -9,11 +9,19 @@
 
 #include "erode_rect_u8.h"
 #include "erode_rect_u16.h"
+#include "erode_rect_u8_vhgw.h"
+#include "erode_rect_u16_vhgw.h"
+#include "erode_rect_u8_binary.h"
+#include "erode_rect_u8_vhgw15x9.h"
+#include "erode_rect_u8_binary15x9.h"
+#include "erode_rect_u8_fused.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
-int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_workbuf__1_buffer))
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_workbuf__1_buffer), bool binary = false,
+         const int window_width = 3, const int window_height = 3)
 {
     try {
         int ret = 0;
@@ -23,11 +31,17 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         //
         const int width = 1024;
         const int height = 768;
-        const int window_width = 3;
-        const int window_height = 3;
         const int iteration = 2;
         const std::vector<int32_t> extents{width, height};
         auto input = mk_rand_buffer<T>(extents);
+        if (binary) {
+            // 0/max mask
+            for (int y=0; y<height; ++y) {
+                for (int x=0; x<width; ++x) {
+                    input(x, y) = input(x, y) & 1 ? std::numeric_limits<T>::max() : 0;
+                }
+            }
+        }
         auto output = mk_null_buffer<T>(extents);
         T (*expect)[width][height], workbuf[2][width][height];
 
@@ -58,6 +72,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         expect = &(workbuf[k%2]);
 
         func(input, output);
+        bench(func, input, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -85,4 +100,27 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(erode_rect_u16);
 #endif
+#ifdef TYPE_u8_vhgw
+    test<uint8_t>(erode_rect_u8_vhgw);
+#endif
+#ifdef TYPE_u16_vhgw
+    test<uint16_t>(erode_rect_u16_vhgw);
+#endif
+#ifdef TYPE_u8_binary
+    test<uint8_t>(erode_rect_u8_binary, true);
+#endif
+    // Large non-square window, where van Herk/Gil-Werman and the packed binary path pay off
+#ifdef TYPE_u8_vhgw15x9
+    test<uint8_t>(erode_rect_u8_vhgw15x9, false, 15, 9);
+#endif
+#ifdef TYPE_u8_binary15x9
+    test<uint8_t>(erode_rect_u8_binary15x9, true, 15, 9);
+#endif
+#ifdef TYPE_u8_fused
+    test<uint8_t>(erode_rect_u8_fused);
+#endif
+#if defined(TYPE_u8_fused) && defined(TYPE_u8)
+    // The fused schedule should give exactly the same result as the unfused one
+    test_same_output<uint8_t>(erode_rect_u8_fused, erode_rect_u8);
+#endif
 }
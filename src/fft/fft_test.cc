@@ -9,6 +9,7 @@
 #include "fft.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace Halide::Runtime;
 
@@ -58,6 +59,7 @@ int main(int argc, char **argv) {
         Buffer<float> output(c, n, batch_size);
         
         fft(input, output);
+        bench(fft, input, output);
 
         for (int i=0; i<batch_size; ++i) {
             std::vector<float2> src(n);
@@ -0,0 +1,28 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename T>
+class FusedIntegral : public Halide::Generator<FusedIntegral<T>> {
+public:
+    ImageParam src{type_of<T>(), 2, "src"};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+
+    Func build() {
+        Func dst{"dst"};
+        dst = Element::fused_integral<T>(src, width, height);
+
+        schedule(src, {width, height});
+        schedule(dst, {width, height});
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(FusedIntegral<uint8_t>, fused_integral_u8);
+HALIDE_REGISTER_GENERATOR(FusedIntegral<uint16_t>, fused_integral_u16);
@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "fused_integral_u8.h"
+#include "fused_integral_u16.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+// S and Q are the narrowest accumulator types of the sum and the squared sum for 1024 x 768 pixels
+template<typename T, typename S, typename Q>
+int test(int (*func)(struct halide_buffer_t *_src_buffer,
+                     struct halide_buffer_t *_dst_0_buffer, struct halide_buffer_t *_dst_1_buffer))
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<T>(extents);
+        auto sum = mk_null_buffer<S>(extents);
+        auto sq_sum = mk_null_buffer<Q>(extents);
+
+        func(input, sum, sq_sum);
+        bench(func, input, sum, sq_sum);
+
+        std::vector<uint64_t> line_sum(width), line_sq_sum(width);
+        for (int y=0; y<height; ++y) {
+            uint64_t s = 0, ss = 0;
+            for (int x=0; x<width; ++x) {
+                s += input(x, y);
+                ss += static_cast<uint64_t>(input(x, y)) * input(x, y);
+                line_sum[x] += s;
+                line_sq_sum[x] += ss;
+                if (line_sum[x] != sum(x, y)) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %llu, actual(%d, %d) = %llu",
+                                                    x, y, static_cast<unsigned long long>(line_sum[x]),
+                                                    x, y, static_cast<unsigned long long>(sum(x, y))).c_str());
+                }
+                if (line_sq_sum[x] != sq_sum(x, y)) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %llu, actual(%d, %d) = %llu",
+                                                    x, y, static_cast<unsigned long long>(line_sq_sum[x]),
+                                                    x, y, static_cast<unsigned long long>(sq_sum(x, y))).c_str());
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main()
+{
+#ifdef TYPE_u8
+    test<uint8_t, uint32_t, uint64_t>(fused_integral_u8);
+#endif
+#ifdef TYPE_u16
+    test<uint16_t, uint64_t, uint64_t>(fused_integral_u16);
+#endif
+}
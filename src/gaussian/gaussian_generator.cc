@@ -4,9 +4,14 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_cpu_at;
+using Halide::Element::schedule_dynamic;
+using Halide::Element::specialize_dynamic;
 
-template<typename T>
-class Gaussian : public Halide::Generator<Gaussian<T>> {
+template<typename T, Element::GaussianAlgorithm A = Element::GaussianAlgorithm::Direct,
+         Element::CPUSchedule S = Element::CPUSchedule::None>
+class Gaussian : public Halide::Generator<Gaussian<T, A, S>> {
 public:
     ImageParam src{type_of<T>(), 2, "src"};
     Param<double> sigma{"sigma", 1.0};
@@ -15,14 +20,36 @@ public:
     GeneratorParam<int32_t> height{"height", 768};
     GeneratorParam<int32_t> window_width{"window_width", 3};
     GeneratorParam<int32_t> window_height{"window_height", 3};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", S, Element::cpu_schedule_enum_map};
+    GeneratorParam<bool> dynamic_shape{"dynamic_shape", false};
+    GeneratorParam<Element::GaussianAlgorithm> algorithm{"algorithm", A, Element::gaussian_algorithm_enum_map};
 
     Func build() {
         Func dst{"dst"};
 
-        dst = Element::gaussian<T>(src, width, height, window_width, window_height, sigma);
+        const bool dynamic = dynamic_shape.value();
+        const std::vector<Expr> shape = dynamic ? std::vector<Expr>{src.width(), src.height()}
+                                                : std::vector<Expr>{width, height};
 
-        schedule(src, {width, height});
-        schedule(dst, {width, height});
+        // Intermediates which are computed per strip or tile of dst, instead of over the whole frame
+        std::vector<Func> stages;
+        const bool fuse = cpu_schedule.value() != Element::CPUSchedule::None;
+        dst = Element::gaussian<T>(src, shape[0], shape[1], window_width, window_height, sigma, algorithm,
+                                   fuse ? &stages : nullptr, this->get_target());
+
+        if (dynamic) {
+            schedule_dynamic(src);
+        } else {
+            schedule(src, {width, height});
+        }
+        schedule(dst, shape);
+        schedule_cpu(dst, shape, cpu_schedule, this->get_target());
+        for (auto& f : stages) {
+            schedule_cpu_at(f, dst, cpu_schedule, this->get_target());
+        }
+        if (dynamic) {
+            specialize_dynamic(dst, src);
+        }
 
         return dst;
     }
@@ -30,3 +57,18 @@ public:
 
 HALIDE_REGISTER_GENERATOR(Gaussian<uint8_t>, gaussian_u8);
 HALIDE_REGISTER_GENERATOR(Gaussian<uint16_t>, gaussian_u16);
+using Gaussian_u8_separable = Gaussian<uint8_t, Element::GaussianAlgorithm::Separable>;
+HALIDE_REGISTER_GENERATOR(Gaussian_u8_separable, gaussian_u8_separable);
+using Gaussian_u16_separable = Gaussian<uint16_t, Element::GaussianAlgorithm::Separable>;
+HALIDE_REGISTER_GENERATOR(Gaussian_u16_separable, gaussian_u16_separable);
+// The row pass is computed per tile of the output
+using Gaussian_u8_separable_tile = Gaussian<uint8_t, Element::GaussianAlgorithm::Separable, Element::CPUSchedule::Tile>;
+HALIDE_REGISTER_GENERATOR(Gaussian_u8_separable_tile, gaussian_u8_separable_tile);
+using Gaussian_u8_recursive = Gaussian<uint8_t, Element::GaussianAlgorithm::Recursive>;
+HALIDE_REGISTER_GENERATOR(Gaussian_u8_recursive, gaussian_u8_recursive);
+using Gaussian_u16_recursive = Gaussian<uint16_t, Element::GaussianAlgorithm::Recursive>;
+HALIDE_REGISTER_GENERATOR(Gaussian_u16_recursive, gaussian_u16_recursive);
+using Gaussian_u8_fixed = Gaussian<uint8_t, Element::GaussianAlgorithm::Fixed>;
+HALIDE_REGISTER_GENERATOR(Gaussian_u8_fixed, gaussian_u8_fixed);
+using Gaussian_u16_fixed = Gaussian<uint16_t, Element::GaussianAlgorithm::Fixed>;
+HALIDE_REGISTER_GENERATOR(Gaussian_u16_fixed, gaussian_u16_fixed);
@@ -8,11 +8,20 @@
 
 #include "gaussian_u8.h"
 #include "gaussian_u16.h"
+#include "gaussian_u8_separable.h"
+#include "gaussian_u16_separable.h"
+#include "gaussian_u8_separable_tile.h"
+#include "gaussian_u8_recursive.h"
+#include "gaussian_u16_recursive.h"
+#include "gaussian_u8_fixed.h"
+#include "gaussian_u16_fixed.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
-int test(int (*func)(struct halide_buffer_t *_src_buffer, double _sigma, struct halide_buffer_t *_dst_buffer))
+int test(int (*func)(struct halide_buffer_t *_src_buffer, double _sigma, struct halide_buffer_t *_dst_buffer),
+         const double sigma = 1.0, const int window_width = 3, const int window_height = 3, const int tolerance = 1)
 {
     try {
         int ret = 0;
@@ -22,19 +31,20 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, double _sigma, struct
         //
         const int width = 1024;
         const int height = 768;
-        const int window_width = 3;
-        const int window_height = 3;
-        const double sigma = 1.0;
         const std::vector<int32_t> extents{width, height};
         auto input = mk_rand_buffer<T>(extents);
         auto output = mk_null_buffer<T>(extents);
 
         func(input, sigma, output);
+        bench(func, input, sigma, output);
         
         double kernel_sum = 0;
+        std::vector<double> kernel(window_width * window_height);
         for (int i = -(window_width/2); i < -(window_width/2) + window_width; i++) {
             for (int j = -(window_height/2); j < -(window_height/2) + window_height; j++) {
-                kernel_sum += exp(-(i * i + j * j) / (2 * sigma * sigma));
+                double k = exp(-(i * i + j * j) / (2 * sigma * sigma));
+                kernel[(j + window_height/2) * window_width + (i + window_width/2)] = k;
+                kernel_sum += k;
             }
         }
 
@@ -45,7 +55,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, double _sigma, struct
                     int yy = std::min(std::max(0, y + j), height - 1);
                     for (int i = -(window_width/2); i < -(window_width/2) + window_width; i++) {
                         int xx = std::min(std::max(0, x + i), width - 1);
-                        expect_f += exp(-(i * i + j * j) / (2 * sigma * sigma)) * input(xx, yy);
+                        expect_f += kernel[(j + window_height/2) * window_width + (i + window_width/2)] * input(xx, yy);
                     }
                 }
                 expect_f /= kernel_sum;
@@ -54,7 +64,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, double _sigma, struct
 
                 // HLS backend の C-simulation と LLVM backend で丸めの方法とexpの実装が異なるため、1以内の誤差を許している
                 // (C-simulation は round half away from zero だが、LLVM 版は round half to even)
-                if (abs(expect - actual) > 1) {
+                if (abs(expect - actual) > tolerance) {
                     printf("dst(%d, %d) = %s = round_f32(%.20f)\n", x, y, std::to_string(expect).c_str(), expect_f);
                     fflush(stdout);
                     throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d, expect_f = %f", x, y, expect, x, y, actual, expect_f).c_str());
@@ -79,4 +89,27 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(gaussian_u16);
 #endif
+#ifdef TYPE_u8_separable
+    test<uint8_t>(gaussian_u8_separable);
+#endif
+#ifdef TYPE_u16_separable
+    test<uint16_t>(gaussian_u16_separable);
+#endif
+#ifdef TYPE_u8_separable_tile
+    test<uint8_t>(gaussian_u8_separable_tile);
+#endif
+#ifdef TYPE_u8_fixed
+    test<uint8_t>(gaussian_u8_fixed);
+#endif
+#ifdef TYPE_u16_fixed
+    test<uint16_t>(gaussian_u16_fixed);
+#endif
+    // Recursive filter approximates the untruncated kernel, which is compared with a window of +-4 sigma.
+    // The approximation error is within 1% of the range.
+#ifdef TYPE_u8_recursive
+    test<uint8_t>(gaussian_u8_recursive, 5.0, 41, 41, std::numeric_limits<uint8_t>::max() / 100 + 1);
+#endif
+#ifdef TYPE_u16_recursive
+    test<uint16_t>(gaussian_u16_recursive, 5.0, 41, 41, std::numeric_limits<uint16_t>::max() / 100 + 1);
+#endif
 }
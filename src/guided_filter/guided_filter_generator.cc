@@ -0,0 +1,32 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+
+template<typename T>
+class GuidedFilter : public Halide::Generator<GuidedFilter<T>> {
+public:
+    ImageParam src{type_of<T>(), 2, "src"};
+    Param<double> eps{"eps", 1.0};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<int32_t> radius{"radius", 4};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+
+    Func build() {
+        Func dst{"dst"};
+        dst = Element::guided_filter<T>(src, width, height, radius, eps);
+
+        schedule(src, {width, height});
+        schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(GuidedFilter<uint8_t>, guided_filter_u8);
+HALIDE_REGISTER_GENERATOR(GuidedFilter<uint16_t>, guided_filter_u16);
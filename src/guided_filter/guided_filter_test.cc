@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "guided_filter_u8.h"
+#include "guided_filter_u16.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+template<typename T>
+int test(int (*func)(struct halide_buffer_t *_src_buffer, double _eps, struct halide_buffer_t *_dst_buffer))
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const int radius = 4;
+        const std::vector<int32_t> extents{width, height};
+        const double eps = (std::numeric_limits<T>::max() / 10.0) * (std::numeric_limits<T>::max() / 10.0);
+        auto input = mk_rand_buffer<T>(extents);
+        auto output = mk_null_buffer<T>(extents);
+
+        func(input, eps, output);
+        bench(func, input, eps, output);
+
+        // Mean over the window clipped to the image
+        auto box_mean = [&](const std::vector<double>& v, int x, int y) {
+            double sum = 0;
+            int count = 0;
+            for (int j=std::max(y - radius, 0); j<=std::min(y + radius, height - 1); ++j) {
+                for (int i=std::max(x - radius, 0); i<=std::min(x + radius, width - 1); ++i) {
+                    sum += v[j * width + i];
+                    count++;
+                }
+            }
+            return sum / count;
+        };
+
+        std::vector<double> in(width * height), sq(width * height);
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                in[y * width + x] = input(x, y);
+                sq[y * width + x] = static_cast<double>(input(x, y)) * input(x, y);
+            }
+        }
+
+        std::vector<double> a(width * height), b(width * height);
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                double mean = box_mean(in, x, y);
+                double var = box_mean(sq, x, y) - mean * mean;
+                a[y * width + x] = var / (var + eps);
+                b[y * width + x] = mean - a[y * width + x] * mean;
+            }
+        }
+
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                double q = box_mean(a, x, y) * input(x, y) + box_mean(b, x, y);
+                T expect = static_cast<T>(std::min(std::max(std::round(q), 0.0),
+                                                   static_cast<double>(std::numeric_limits<T>::max())));
+                T actual = output(x, y);
+                // Summed area tables may flip rounding of the exact result
+                if (abs(expect - actual) > 1) {
+                    throw std::runtime_error(format("Error: expect(%d, %d) = %d, actual(%d, %d) = %d",
+                                                    x, y, expect, x, y, actual).c_str());
+                }
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main()
+{
+#ifdef TYPE_u8
+    test<uint8_t>(guided_filter_u8);
+#endif
+#ifdef TYPE_u16
+    test<uint16_t>(guided_filter_u16);
+#endif
+}
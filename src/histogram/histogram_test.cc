@@ -11,6 +11,7 @@
 #include "histogram_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer))
@@ -49,6 +50,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         }
 
         func(input, output);
+        bench(func, input, output);
 
         for (int x=0; x<hist_width; ++x) {
             uint32_t actual = output(x);
@@ -11,6 +11,7 @@
 #include "histogram2d_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src0_buffer, struct halide_buffer_t *_src1_buffer, struct halide_buffer_t *_dst_buffer))
@@ -45,6 +46,7 @@ int test(int (*func)(struct halide_buffer_t *_src0_buffer, struct halide_buffer_
         }
 
         func(input0, input1, output);
+        bench(func, input0, input1, output);
 
         for (int y=0; y<hist_width; ++y) {
             for (int x=0; x<hist_width; ++x) {
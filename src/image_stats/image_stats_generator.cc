@@ -0,0 +1,30 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename T>
+class ImageStats : public Halide::Generator<ImageStats<T>> {
+public:
+    ImageParam src{type_of<T>(), 2, "src"};
+    ImageParam roi{type_of<uint8_t>(), 2, "roi"};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+
+    Func build() {
+        Func dst{"dst"};
+        dst = Element::image_stats<T>(src, roi, width, height);
+
+        schedule(src, {width, height});
+        schedule(roi, {width, height});
+        schedule(dst, {1});
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(ImageStats<uint8_t>, image_stats_u8);
+HALIDE_REGISTER_GENERATOR(ImageStats<uint16_t>, image_stats_u16);
@@ -0,0 +1,98 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "image_stats_u8.h"
+#include "image_stats_u16.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+template<typename T>
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_roi_buffer,
+                     struct halide_buffer_t *_dst_0_buffer, struct halide_buffer_t *_dst_1_buffer,
+                     struct halide_buffer_t *_dst_2_buffer, struct halide_buffer_t *_dst_3_buffer,
+                     struct halide_buffer_t *_dst_4_buffer, struct halide_buffer_t *_dst_5_buffer,
+                     struct halide_buffer_t *_dst_6_buffer))
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<T>(extents);
+        auto roi = mk_rand_buffer<uint8_t>(extents);
+        auto count = mk_null_buffer<uint32_t>({1});
+        auto sum = mk_null_buffer<uint64_t>({1});
+        auto sq_sum = mk_null_buffer<uint64_t>({1});
+        auto min = mk_null_buffer<T>({1});
+        auto max = mk_null_buffer<T>({1});
+        auto argmin = mk_null_buffer<uint32_t>({1});
+        auto argmax = mk_null_buffer<uint32_t>({1});
+
+        // Mask out about half of the pixels
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                roi(x, y) = roi(x, y) < 128 ? 0 : roi(x, y);
+            }
+        }
+
+        func(input, roi, count, sum, sq_sum, min, max, argmin, argmax);
+        bench(func, input, roi, count, sum, sq_sum, min, max, argmin, argmax);
+
+        uint64_t expect[7] = {0, 0, 0, 0, 0, 0, 0};
+        T min_v = std::numeric_limits<T>::max();
+        T max_v = std::numeric_limits<T>::min();
+        for (int y=0; y<height; ++y) {
+            for (int x=0; x<width; ++x) {
+                if (roi(x, y) == 0) {
+                    continue;
+                }
+                const T v = input(x, y);
+                expect[0]++;
+                expect[1] += v;
+                expect[2] += static_cast<uint64_t>(v) * v;
+                if (expect[0] == 1 || v < min_v) {
+                    min_v = v;
+                    expect[5] = y * width + x;
+                }
+                if (expect[0] == 1 || v > max_v) {
+                    max_v = v;
+                    expect[6] = y * width + x;
+                }
+            }
+        }
+        expect[3] = expect[0] == 0 ? 0 : min_v;
+        expect[4] = expect[0] == 0 ? 0 : max_v;
+
+        const char *names[7] = {"count", "sum", "sq_sum", "min", "max", "argmin", "argmax"};
+        const uint64_t actual[7] = {count(0), sum(0), sq_sum(0), min(0), max(0), argmin(0), argmax(0)};
+        for (int i=0; i<7; ++i) {
+            if (expect[i] != actual[i]) {
+                throw std::runtime_error(format("Error: %s, expect = %llu, actual = %llu", names[i],
+                                                static_cast<unsigned long long>(expect[i]),
+                                                static_cast<unsigned long long>(actual[i])).c_str());
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main()
+{
+#ifdef TYPE_u8
+    test<uint8_t>(image_stats_u8);
+#endif
+#ifdef TYPE_u16
+    test<uint16_t>(image_stats_u16);
+#endif
+}
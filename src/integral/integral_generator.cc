@@ -5,13 +5,13 @@
 using namespace Halide;
 using Halide::Element::schedule;
 
-template<typename T, typename D>
-class Integral : public Halide::Generator<Integral<T, D>> {
+template<typename T, typename D, int32_t W = 1024, int32_t H = 768>
+class Integral : public Halide::Generator<Integral<T, D, W, H>> {
 public:
     ImageParam src{type_of<T>(), 2, "src"};
 
-    GeneratorParam<int32_t> width{"width", 1024};
-    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<int32_t> width{"width", W};
+    GeneratorParam<int32_t> height{"height", H};
 
     Func build() {
         Func dst{"dst"};
@@ -36,3 +36,6 @@ using Integral_u16_f64 = Integral<uint16_t, double>;
 HALIDE_REGISTER_GENERATOR(Integral_u16_f64 , integral_u16_f64);
 using Integral_u32_f64 = Integral<uint32_t, double>;
 HALIDE_REGISTER_GENERATOR(Integral_u32_f64 , integral_u32_f64);
+// Narrower than 8 tiles of the row scan, and not a multiple of the vector width
+using Integral_u8_f64_narrow = Integral<uint8_t, double, 100, 48>;
+HALIDE_REGISTER_GENERATOR(Integral_u8_f64_narrow , integral_u8_f64_narrow);
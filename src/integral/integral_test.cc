@@ -13,11 +13,14 @@
 #include "integral_u8_f64.h"
 #include "integral_u16_f64.h"
 #include "integral_u32_f64.h"
+#include "integral_u8_f64_narrow.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T, typename D>
-int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer))
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer),
+         const int width = 1024, const int height = 768)
 {
     try {
         int ret = 0;
@@ -25,13 +28,11 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         //
         // Run
         //
-        const int width = 1024;
-        const int height = 768;
         const std::vector<int32_t> extents{width, height};
         auto input = mk_rand_buffer<T>(extents);
         auto output = mk_null_buffer<D>(extents);
 
-        D expect[height * width];
+        std::vector<D> expect(height * width);
         
         // Reference impl.
         std::vector<uint64_t> line_buffer(width);
@@ -45,6 +46,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         }
 
         func(input, output);
+        bench(func, input, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -84,4 +86,7 @@ int main()
 #ifdef TYPE_u32_f64
     test<uint32_t, double>(integral_u32_f64);
 #endif
+#ifdef TYPE_u8_f64_narrow
+    test<uint8_t, double>(integral_u8_f64_narrow, 100, 48);
+#endif
 }
@@ -4,6 +4,9 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_dynamic;
+using Halide::Element::specialize_dynamic;
 
 template<typename T>
 class Laplacian : public Halide::Generator<Laplacian<T>> {
@@ -12,13 +15,27 @@ public:
 
     GeneratorParam<int32_t> width{"width", 8};
     GeneratorParam<int32_t> height{"height", 8};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<bool> dynamic_shape{"dynamic_shape", false};
 
     Func build() {
         Func dst{"dst"};
-        dst = Element::laplacian<T>(src, width, height);
+        const bool dynamic = dynamic_shape.value();
+        const std::vector<Expr> shape = dynamic ? std::vector<Expr>{src.width(), src.height()}
+                                                : std::vector<Expr>{width, height};
 
-        schedule(src, {width, height});
-        schedule(dst, {width, height});
+        dst = Element::laplacian<T>(src, shape[0], shape[1]);
+
+        if (dynamic) {
+            schedule_dynamic(src);
+        } else {
+            schedule(src, {width, height});
+        }
+        schedule(dst, shape);
+        schedule_cpu(dst, shape, cpu_schedule, this->get_target());
+        if (dynamic) {
+            specialize_dynamic(dst, src);
+        }
 
         return dst;
     }
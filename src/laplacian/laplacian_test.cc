@@ -10,6 +10,7 @@
 #include "laplacian_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 #define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
 
@@ -31,6 +32,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<T>(extents);
 
         func(input, output);
+        bench(func, input, output);
 
         double kernel[3][3] = {{-1, -1, -1}, {-1, 8, -1}, {-1, -1, -1}};
 
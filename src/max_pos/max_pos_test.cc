@@ -9,6 +9,7 @@
 #include "max_pos_f32.h"
 #include "max_pos_f64.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using std::string;
 using std::vector;
@@ -70,6 +71,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<uint32_t>({2});
 
         func(input, output);
+        bench(func, input, output);
 
         uint32_t expect_x, expect_y;
         std::tie(expect_x, expect_y) = max_pos_ref<T>(input, width, height);
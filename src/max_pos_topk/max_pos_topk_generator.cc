@@ -0,0 +1,31 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename T>
+class MaxPosTopk : public Halide::Generator<MaxPosTopk<T>> {
+public:
+    ImageParam src{type_of<T>(), 2, "src"};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<int32_t> k{"k", 8};
+
+    Func build() {
+        Func dst{"dst"};
+
+        dst = Element::max_pos_topk(src, width, height, k);
+
+        schedule(src, {width, height});
+        schedule(dst, {2, k});
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(MaxPosTopk<uint8_t>, max_pos_topk_u8);
+HALIDE_REGISTER_GENERATOR(MaxPosTopk<uint16_t>, max_pos_topk_u16);
+HALIDE_REGISTER_GENERATOR(MaxPosTopk<float>, max_pos_topk_f32);
@@ -0,0 +1,51 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "max_pos_topk_u8.h"
+#include "max_pos_topk_u16.h"
+#include "max_pos_topk_f32.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+template<typename T>
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer))
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const int k = 8;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<T>(extents);
+        auto output = mk_null_buffer<uint32_t>({2, k});
+
+        func(input, output);
+        bench(func, input, output);
+
+        check_pos_topk(input, output, k, true);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main()
+{
+#ifdef TYPE_u8
+    test<uint8_t>(max_pos_topk_u8);
+#endif
+#ifdef TYPE_u16
+    test<uint16_t>(max_pos_topk_u16);
+#endif
+#ifdef TYPE_f32
+    test<float>(max_pos_topk_f32);
+#endif
+}
@@ -0,0 +1,36 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename T>
+class MaxValueSpans : public Halide::Generator<MaxValueSpans<T>> {
+public:
+    ImageParam src{type_of<T>(), 2, "src"};
+    ImageParam spans{Int(32), 2, "spans"};
+    Param<int32_t> num_spans{"num_spans", 0};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<int32_t> max_spans{"max_spans", 1024};
+
+    Func build() {
+        Func dst{"dst"};
+
+        // Asserts are off, so num_spans is also clamped to the spans buffer
+        num_spans.set_range(0, max_spans);
+        dst = Element::max_value_spans<T>(src, width, height, spans, clamp(num_spans, 0, max_spans), width);
+
+        schedule(src, {width, height});
+        schedule(spans, {3, max_spans});
+        schedule(dst, {1});
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(MaxValueSpans<uint8_t>, max_value_spans_u8);
+HALIDE_REGISTER_GENERATOR(MaxValueSpans<uint16_t>, max_value_spans_u16);
+HALIDE_REGISTER_GENERATOR(MaxValueSpans<uint32_t>, max_value_spans_u32);
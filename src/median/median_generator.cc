@@ -4,24 +4,28 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
-template<typename T>
-class Median : public Halide::Generator<Median<T>> {
+template<typename T, Element::MedianAlgorithm A = Element::MedianAlgorithm::Sort, int32_t W = 3>
+class Median : public Halide::Generator<Median<T, A, W>> {
 public:
     ImageParam src{type_of<T>(), 2, "src"};
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
-    GeneratorParam<int32_t> window_width{"window_width", 3};
-    GeneratorParam<int32_t> window_height{"window_height", 3};
+    GeneratorParam<int32_t> window_width{"window_width", W};
+    GeneratorParam<int32_t> window_height{"window_height", W};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MedianAlgorithm> algorithm{"algorithm", A, Element::median_algorithm_enum_map};
 
     Func build() {
         Func dst{"dst"};
 
-        dst = Element::median(src, width, height, window_width, window_height);
+        dst = Element::median(src, width, height, window_width, window_height, algorithm, this->get_target());
 
         schedule(src, {width, height});
         schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
 
         return dst;
     }
@@ -29,3 +33,11 @@ public:
 
 HALIDE_REGISTER_GENERATOR(Median<uint8_t>, median_u8);
 HALIDE_REGISTER_GENERATOR(Median<uint16_t>, median_u16);
+using Median_u8_histogram = Median<uint8_t, Element::MedianAlgorithm::Histogram>;
+HALIDE_REGISTER_GENERATOR(Median_u8_histogram, median_u8_histogram);
+using Median_u8_network = Median<uint8_t, Element::MedianAlgorithm::Network>;
+HALIDE_REGISTER_GENERATOR(Median_u8_network, median_u8_network);
+using Median_u16_network = Median<uint16_t, Element::MedianAlgorithm::Network>;
+HALIDE_REGISTER_GENERATOR(Median_u16_network, median_u16_network);
+using Median_u8_network5x5 = Median<uint8_t, Element::MedianAlgorithm::Network, 5>;
+HALIDE_REGISTER_GENERATOR(Median_u8_network5x5, median_u8_network5x5);
@@ -8,13 +8,19 @@
 
 #include "median_u8.h"
 #include "median_u16.h"
+#include "median_u8_histogram.h"
+#include "median_u8_network.h"
+#include "median_u16_network.h"
+#include "median_u8_network5x5.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 #define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
 
 template<typename T>
-int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer))
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer),
+         const int window_width = 3, const int window_height = 3)
 {
     try {
         int ret = 0;
@@ -24,13 +30,12 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         //
         const int width = 1024;
         const int height = 768;
-        const int window_width = 3;
-        const int window_height = 3;
         const std::vector<int32_t> extents{width, height};
         auto input = mk_rand_buffer<T>(extents);
         auto output = mk_null_buffer<T>(extents);
 
         func(input, output);
+        bench(func, input, output);
         T expect[height][width];
 
         
@@ -81,4 +86,16 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(median_u16);
 #endif
+#ifdef TYPE_u8_histogram
+    test<uint8_t>(median_u8_histogram);
+#endif
+#ifdef TYPE_u8_network
+    test<uint8_t>(median_u8_network);
+#endif
+#ifdef TYPE_u16_network
+    test<uint16_t>(median_u16_network);
+#endif
+#ifdef TYPE_u8_network5x5
+    test<uint8_t>(median_u8_network5x5, 5, 5);
+#endif
 }
@@ -4,6 +4,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class Merge3 : public Halide::Generator<Merge3<T>> {
@@ -14,6 +15,7 @@ public:
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Func build() {
         Func dst{"dst"};
@@ -24,6 +26,7 @@ public:
         schedule(src1, {width, height});
         schedule(src2, {width, height});
         schedule(dst, {3, width, height});
+        schedule_cpu(dst, {3, width, height}, cpu_schedule, this->get_target());
 
         return dst;
     }
@@ -13,6 +13,7 @@
 #include "merge3_i16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src_buffer1,
@@ -49,6 +50,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer1,
         }
 
         func(input[0], input[1], input[2], output);
+        bench(func, input[0], input[1], input[2], output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -4,6 +4,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class Merge4 : public Halide::Generator<Merge4<T>> {
@@ -15,6 +16,7 @@ public:
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Func build() {
         Func dst{"dst"};
@@ -26,6 +28,7 @@ public:
         schedule(src2, {width, height});
         schedule(src3, {width, height});
         schedule(dst, {4, width, height});
+        schedule_cpu(dst, {4, width, height}, cpu_schedule, this->get_target());
 
         return dst;
     }
@@ -9,6 +9,7 @@
 #include "min_pos_f32.h"
 #include "min_pos_f64.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using std::string;
 using std::vector;
@@ -59,6 +60,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<uint32_t>({2});
 
         func(input, output);
+        bench(func, input, output);
 
         uint32_t expect_x, expect_y;
         std::tie(expect_x, expect_y) = min_pos_ref<T>(input, width, height);
@@ -0,0 +1,31 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename T>
+class MinPosTopk : public Halide::Generator<MinPosTopk<T>> {
+public:
+    ImageParam src{type_of<T>(), 2, "src"};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<int32_t> k{"k", 8};
+
+    Func build() {
+        Func dst{"dst"};
+
+        dst = Element::min_pos_topk(src, width, height, k);
+
+        schedule(src, {width, height});
+        schedule(dst, {2, k});
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(MinPosTopk<uint8_t>, min_pos_topk_u8);
+HALIDE_REGISTER_GENERATOR(MinPosTopk<uint16_t>, min_pos_topk_u16);
+HALIDE_REGISTER_GENERATOR(MinPosTopk<float>, min_pos_topk_f32);
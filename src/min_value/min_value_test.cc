@@ -7,6 +7,7 @@
 #include "min_value_u16.h"
 #include "min_value_u32.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using std::string;
 using std::vector;
@@ -48,6 +49,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<T>({1});
 
         func(input, roi, output);
+        bench(func, input, roi, output);
 
         T expect = min_value_ref<T>(input, roi, width, height);
         T actual = output(0);
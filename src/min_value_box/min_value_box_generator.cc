@@ -0,0 +1,36 @@
+#include <cstdint>
+#include "Halide.h"
+#include "Element.h"
+
+using namespace Halide;
+using Halide::Element::schedule;
+
+template<typename T>
+class MinValueBox : public Halide::Generator<MinValueBox<T>> {
+public:
+    ImageParam src{type_of<T>(), 2, "src"};
+    ImageParam roi{type_of<uint8_t>(), 2, "roi"};
+    Param<int32_t> box_x{"box_x", 0};
+    Param<int32_t> box_y{"box_y", 0};
+    Param<int32_t> box_width{"box_width", 1};
+    Param<int32_t> box_height{"box_height", 1};
+
+    GeneratorParam<int32_t> width{"width", 1024};
+    GeneratorParam<int32_t> height{"height", 768};
+
+    Func build() {
+        Func dst{"dst"};
+
+        dst = Element::min_value_box<T>(src, roi, width, height, box_x, box_y, box_width, box_height);
+
+        schedule(src, {width, height});
+        schedule(roi, {width, height});
+        schedule(dst, {1});
+
+        return dst;
+    }
+};
+
+HALIDE_REGISTER_GENERATOR(MinValueBox<uint8_t>, min_value_box_u8);
+HALIDE_REGISTER_GENERATOR(MinValueBox<uint16_t>, min_value_box_u16);
+HALIDE_REGISTER_GENERATOR(MinValueBox<uint32_t>, min_value_box_u32);
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <exception>
+
+#include "HalideRuntime.h"
+#include "HalideBuffer.h"
+
+#include "min_value_box_u8.h"
+#include "min_value_box_u16.h"
+#include "min_value_box_u32.h"
+
+#include "test_common.h"
+#include "bench_common.h"
+
+template <typename T>
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_roi_buffer,
+                     int32_t _box_x, int32_t _box_y, int32_t _box_width, int32_t _box_height,
+                     struct halide_buffer_t *_dst_buffer))
+{
+    try {
+        const int width = 1024;
+        const int height = 768;
+        const std::vector<int32_t> extents{width, height};
+        auto input = mk_rand_buffer<T>(extents);
+        auto output = mk_null_buffer<T>({1});
+
+        // Only the pixels of roi in the box are counted, though roi is not 0 outside of it
+        auto roi = mk_rand_buffer<uint8_t>(extents);
+        // {x, y, width, height} of the box at the center, at the corners of the frame, overhanging the frame,
+        // outside of the frame, and at the center again after roi is cleared in it, where no pixel is counted
+        const std::vector<std::array<int32_t, 4>> boxes{
+            {480, 352, 64, 48}, {0, 0, 64, 48}, {width - 64, height - 48, 64, 48},
+            {-16, -16, 64, 48}, {width - 32, height - 24, 64, 48}, {width, 0, 64, 48}, {480, 352, 64, 48}
+        };
+
+        for (size_t n=0; n<boxes.size(); ++n) {
+            const int32_t box_x = boxes[n][0], box_y = boxes[n][1], box_width = boxes[n][2], box_height = boxes[n][3];
+            if (n == boxes.size() - 1) {
+                for (int y=box_y; y<box_y+box_height; ++y) {
+                    for (int x=box_x; x<box_x+box_width; ++x) {
+                        roi(x, y) = 0;
+                    }
+                }
+            }
+
+            func(input, roi, box_x, box_y, box_width, box_height, output);
+            if (n == 0) {
+                bench(func, input, roi, box_x, box_y, box_width, box_height, output);
+            }
+
+            T value = std::numeric_limits<T>::max();
+            int count = 0;
+            // Only the part of the box in the frame is visited
+            const int x0 = std::max(box_x, 0), x1 = std::min(box_x + box_width, width);
+            const int y0 = std::max(box_y, 0), y1 = std::min(box_y + box_height, height);
+            for (int y=y0; y<y1; ++y) {
+                for (int x=x0; x<x1; ++x) {
+                    if (roi(x, y) == 0) {
+                        continue;
+                    }
+                    value = input(x, y) < value ? input(x, y) : value;
+                    count++;
+                }
+            }
+            const T expect = count == 0 ? 0 : value;
+            const T actual = output(0);
+            if (expect != actual) {
+                throw std::runtime_error(format("Error: case %zu, expect = %llu, actual = %llu", n,
+                                                static_cast<unsigned long long>(expect),
+                                                static_cast<unsigned long long>(actual)));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printf("Success!\n");
+    return 0;
+}
+
+int main()
+{
+#ifdef TYPE_u8
+    test<uint8_t>(min_value_box_u8);
+#endif
+#ifdef TYPE_u16
+    test<uint16_t>(min_value_box_u16);
+#endif
+#ifdef TYPE_u32
+    test<uint32_t>(min_value_box_u32);
+#endif
+}
@@ -9,6 +9,7 @@
 #include "HalideBuffer.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 #include "mnist.h"
 
@@ -88,6 +89,7 @@ int main(int argc, char **argv) {
         Buffer<float> out(classes, batch_size);
 
         mnist(in, out);
+        bench(mnist, in, out);
 
         Buffer<int> labels = load_data<int>("data/test_label_b1.bin");
 
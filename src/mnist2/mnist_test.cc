@@ -10,6 +10,7 @@
 #include "HalideBuffer.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 #include "mnist.h"
 
@@ -108,6 +109,7 @@ int main(int argc, char **argv) {
         // Buffer<float> out(20, 24, 24, batch_size);
 
         mnist(in, out);
+        bench(mnist, in, out);
 
         Buffer<int> labels = load_data<int>("data/mnist_label.bin");
 
@@ -7,6 +7,7 @@
 #include "multiply_u16.h"
 #include "multiply_u32.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace Halide::Runtime;
 
@@ -26,6 +27,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer1, struct halide_buffer_
         auto output = mk_null_buffer<T>(extents);
         
         func(src1, src2, output);
+        bench(func, src1, src2, output);
         
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
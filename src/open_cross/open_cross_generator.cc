@@ -5,6 +5,8 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_fused;
 
 template<typename T>
 class OpenCross : public Halide::Generator<OpenCross<T>> {
@@ -16,16 +18,28 @@ public:
     GeneratorParam<int32_t> iteration{"iteration", 2};
     GeneratorParam<int32_t> window_width{"window_width", 3, 3, 17};
     GeneratorParam<int32_t> window_height{"window_height", 3, 3, 17};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<Element::MorphologyAlgorithm> algorithm{"algorithm", Element::MorphologyAlgorithm::Direct, Element::morphology_algorithm_enum_map};
+    GeneratorParam<bool> fuse_iterations{"fuse_iterations", false};
 
     Func build() {
         Func erode{"erode"}, dilate{"dilate"};
+        Element::MorphologyStages stages;
 
-        erode = Element::erode_cross<T>(src, width, height, window_width, window_height, iteration);
-        dilate = Element::dilate_cross<T>(erode, width, height, window_width, window_height, iteration);
+        erode = Element::erode_cross<T>(src, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr);
+        dilate = Element::dilate_cross<T>(erode, width, height, window_width, window_height, iteration, algorithm, fuse_iterations ? &stages : nullptr);
 
         schedule(src, {width, height});
-        schedule(erode, {width, height});
-        schedule(dilate, {width, height});
+        if (fuse_iterations) {
+            stages.push_back(erode);
+            schedule(dilate, {width, height});
+            schedule_fused(dilate, stages, {width, height}, cpu_schedule, this->get_target());
+        } else {
+            schedule(erode, {width, height});
+            schedule_cpu(erode, {width, height}, cpu_schedule, this->get_target());
+            schedule(dilate, {width, height});
+            schedule_cpu(dilate, {width, height}, cpu_schedule, this->get_target());
+        }
 
         return dilate;
     }
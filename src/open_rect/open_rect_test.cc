@@ -9,8 +9,10 @@
 
 #include "open_rect_u8.h"
 #include "open_rect_u16.h"
+#include "open_rect_u8_fused.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 // returns index of result workbuf
 template<typename T>
@@ -74,6 +76,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         expect = &(workbuf[k%2]);
 
         func(input, output);
+        bench(func, input, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -101,5 +104,12 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(open_rect_u16);
 #endif
+#ifdef TYPE_u8_fused
+    test<uint8_t>(open_rect_u8_fused);
+#endif
+#if defined(TYPE_u8_fused) && defined(TYPE_u8)
+    // The fused schedule should give exactly the same result as the unfused one
+    test_same_output<uint8_t>(open_rect_u8_fused, open_rect_u8);
+#endif
 }
 
@@ -9,6 +9,7 @@
 
 #include "poc.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace Halide::Runtime;
 
@@ -43,6 +44,7 @@ int main()
         }
 
         poc(input1, input2, output);
+        bench(poc, input1, input2, output);
 
         int max_x = 0;
         int max_y = 0;
@@ -5,6 +5,9 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
+using Halide::Element::schedule_dynamic;
+using Halide::Element::specialize_dynamic;
 
 template<typename T>
 class Prewitt : public Generator<Prewitt<T>> {
@@ -13,14 +16,28 @@ public:
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<bool> dynamic_shape{"dynamic_shape", false};
 
     Func build() {
         Func output{"output"};
 
-        output = Element::prewitt<T>(input, width, height);
-
-        schedule(input, {width, height});
-        schedule(output, {width, height});
+        const bool dynamic = dynamic_shape.value();
+        const std::vector<Expr> shape = dynamic ? std::vector<Expr>{input.width(), input.height()}
+                                                : std::vector<Expr>{width, height};
+
+        output = Element::prewitt<T>(input, shape[0], shape[1]);
+
+        if (dynamic) {
+            schedule_dynamic(input);
+        } else {
+            schedule(input, {width, height});
+        }
+        schedule(output, shape);
+        schedule_cpu(output, shape, cpu_schedule, this->get_target());
+        if (dynamic) {
+            specialize_dynamic(output, input);
+        }
 
         return output;
     }
@@ -7,6 +7,7 @@
 #include "prewitt_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_input_buffer, struct halide_buffer_t *_output_buffer))
@@ -46,6 +47,7 @@ int test(int (*func)(struct halide_buffer_t *_input_buffer, struct halide_buffer
         }
 
         func(input, output);
+        bench(func, input, output);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -4,6 +4,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class Sad : public Halide::Generator<Sad<T>> {
@@ -15,6 +16,7 @@ public:
     GeneratorParam<int32_t> height{"height", 768};
     //GeneratorParam<int32_t> width{"width", 10};
     //GeneratorParam<int32_t> height{"height", 8};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Func build() {
         Func dst{"dst"};
@@ -24,6 +26,7 @@ public:
         schedule(src0, {width, height});
         schedule(src1, {width, height});
         schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
 
         return dst;
     }
@@ -12,6 +12,7 @@
 #include "sad_u32.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace std;
 
@@ -53,6 +54,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer1,
 		}
 
         func(input[0], input[1], output);
+        bench(func, input[0], input[1], output);
 
 //		cout << "input[0]" << endl;
 //        for (int y=0; y<height; ++y) {
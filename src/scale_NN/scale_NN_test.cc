@@ -12,6 +12,7 @@
 #include "scale_NN_i16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 Halide::Runtime::Buffer<T>& ref_NN(Halide::Runtime::Buffer<T>& dst, const Halide::Runtime::Buffer<T>& src,
@@ -52,6 +53,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<T>(out_extents);
 
         func(input, output); //onl NN yet
+        bench(func, input, output);
         auto expect = mk_null_buffer<T>(out_extents);
 
         expect = ref_NN(expect, input, in_width, in_height, out_width, out_height);
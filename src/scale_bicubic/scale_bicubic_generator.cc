@@ -6,6 +6,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class ScaleBicubic : public Halide::Generator<ScaleBicubic<T>> {
@@ -16,6 +17,7 @@ class ScaleBicubic : public Halide::Generator<ScaleBicubic<T>> {
 
     GeneratorParam<int32_t> out_width{"out_width", 500};
     GeneratorParam<int32_t> out_height{"out_height", 500};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
 public:
     Func build() {
@@ -24,6 +26,7 @@ public:
 
         schedule(src, {in_width, in_height});
         schedule(dst, {out_width, out_height});
+        schedule_cpu(dst, {out_width, out_height}, cpu_schedule, this->get_target());
         return dst;
     }
 };
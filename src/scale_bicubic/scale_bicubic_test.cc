@@ -12,6 +12,7 @@
 #include "scale_bicubic_i16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 #define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
 
@@ -97,6 +98,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         auto output = mk_null_buffer<T>(out_extents);
 
         func(input, output);
+        bench(func, input, output);
         auto expect = mk_null_buffer<T>(out_extents);
         expect = ref_bicubic(expect, input, in_width, in_height, out_width, out_height);
 
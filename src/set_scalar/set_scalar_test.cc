@@ -11,6 +11,7 @@
 #include "set_scalar_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace Halide::Runtime;
 
@@ -24,6 +25,7 @@ int test(int (*func)(T _value, struct halide_buffer_t *_dst_buffer)) {
         auto output = mk_null_buffer<T>(extents);
 
         func(value, output);
+        bench(func, value, output);
         //for each x and y
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
@@ -12,6 +12,7 @@ public:
     GeneratorParam<int32_t> disp{"disp", 16};
     GeneratorParam<int32_t> width{"width", 641};
     GeneratorParam<int32_t> height{"height", 555};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Func build()
     {
@@ -22,6 +23,7 @@ public:
         schedule(in_l, {width, height});
         schedule(in_r, {width, height});
         schedule(out, {width, height});
+        schedule_cpu(out, {width, height}, cpu_schedule, this->get_target());
 
         return out;
     }
@@ -4,6 +4,7 @@
 #include "HalideBuffer.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 #include "run_common.h"
 
 #include "sgm.h"
@@ -21,6 +22,7 @@ int main(int argc, char **argv) {
         Buffer<uint8_t> out(width, height);
 
         sgm(in_l, in_r, out);
+        bench(sgm, in_l, in_r, out);
         
         Buffer<uint8_t> disp = load_pgm("data/disp.pgm");
 
@@ -12,14 +12,17 @@ class SimpleISP : public Halide::Generator<SimpleISP> {
 
     GeneratorParam<int32_t> width{"width", 3280};
     GeneratorParam<int32_t> height{"height", 2486};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
+    GeneratorParam<bool> dynamic_shape{"dynamic_shape", false};
 
 public:
     Func build()
     {
         constexpr uint32_t frac_bits = 10;
 
-        int32_t w = static_cast<int32_t>(width);
-        int32_t h = static_cast<int32_t>(height);
+        const bool dynamic = dynamic_shape.value();
+        Expr w = dynamic ? in.width() : Expr(static_cast<int32_t>(width));
+        Expr h = dynamic ? in.height() : Expr(static_cast<int32_t>(height));
 
         Var c, x, y;
         Func f0("optical_black_clamp");
@@ -45,10 +48,20 @@ public:
         Func out("out");
         out(c, x, y) = select(c == 3, 0, denormalize<frac_bits>(f5)(c, x, y));
 
-        schedule(in, {w, h});
+        if (dynamic) {
+            schedule_dynamic(in);
+        } else {
+            schedule(in, {w, h});
+        }
         schedule(f2, {3, w, h}).unroll(c);
+        schedule_cpu(f2, {3, w, h}, cpu_schedule, this->get_target());
         schedule(f4, {3, w, h}).unroll(c);
+        schedule_cpu(f4, {3, w, h}, cpu_schedule, this->get_target());
         schedule(out, {4, w, h}).unroll(c);
+        schedule_cpu(out, {4, w, h}, cpu_schedule, this->get_target());
+        if (dynamic) {
+            specialize_dynamic(out, in);
+        }
 
         return out;
     }
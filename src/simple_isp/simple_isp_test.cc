@@ -11,6 +11,7 @@
 #include "simple_isp.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 using namespace Halide::Runtime;
 
@@ -66,6 +67,7 @@ int main(int argc, char **argv) {
         const float saturation_value = 0.6f;
         
         simple_isp(input, optical_black_clamp_value, gamma_value, saturation_value, output);
+        bench(simple_isp, input, optical_black_clamp_value, gamma_value, saturation_value, output);
        
         save_ppm("out.ppm", output);
     } catch (const std::exception& e) {
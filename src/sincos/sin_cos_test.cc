@@ -11,6 +11,7 @@
 #include "sin_cos.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 int test(int (*func)(struct halide_buffer_t *_src_buffer1, struct halide_buffer_t *_dst_buffer))
 {
@@ -27,6 +28,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer1, struct halide_buffer_
         auto output = mk_null_buffer<float>(extents);
 
         func(input, output);
+        bench(func, input, output);
 
         double diff_max = 0.0;
         for (int y=0; y<height; ++y) {
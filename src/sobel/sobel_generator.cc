@@ -4,20 +4,34 @@
 using namespace Halide;
 using namespace Halide::Element;
 
-template<typename T>
-class Sobel : public Generator<Sobel<T>> {
+template<typename T, Element::CPUSchedule S = Element::CPUSchedule::None, bool D = false>
+class Sobel : public Generator<Sobel<T, S, D>> {
 public:
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", S, Element::cpu_schedule_enum_map};
+    GeneratorParam<bool> dynamic_shape{"dynamic_shape", D};
     ImageParam input{type_of<T>(), 2, "input"};
 
     Func build() {
         Func output{"output"};
 
-        output = Element::sobel<T>(input, width, height);
+        const bool dynamic = dynamic_shape.value();
+        const std::vector<Expr> shape = dynamic ? std::vector<Expr>{input.width(), input.height()}
+                                                : std::vector<Expr>{width, height};
 
-        schedule(input, {width, height});
-        schedule(output, {width, height});
+        output = Element::sobel<T>(input, shape[0], shape[1]);
+
+        if (dynamic) {
+            schedule_dynamic(input);
+        } else {
+            schedule(input, {width, height});
+        }
+        schedule(output, shape);
+        schedule_cpu(output, shape, cpu_schedule, this->get_target());
+        if (dynamic) {
+            specialize_dynamic(output, input);
+        }
 
         return output;
     }
@@ -26,4 +40,8 @@ public:
 
 HALIDE_REGISTER_GENERATOR(Sobel<uint8_t>, sobel_u8);
 HALIDE_REGISTER_GENERATOR(Sobel<uint16_t>, sobel_u16);
+using Sobel_u8_tile = Sobel<uint8_t, Element::CPUSchedule::Tile>;
+HALIDE_REGISTER_GENERATOR(Sobel_u8_tile, sobel_u8_tile);
+using Sobel_u8_dynamic = Sobel<uint8_t, Element::CPUSchedule::ParallelVectorize, true>;
+HALIDE_REGISTER_GENERATOR(Sobel_u8_dynamic, sobel_u8_dynamic);
 
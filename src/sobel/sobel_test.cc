@@ -5,12 +5,16 @@
 
 #include "sobel_u8.h"
 #include "sobel_u16.h"
+#include "sobel_u8_tile.h"
+#include "sobel_u8_dynamic.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 #include "cstdlib"
 
 template<typename T>
-int test(int (*func)(struct halide_buffer_t *_input_buffer, struct halide_buffer_t *_output_buffer))
+int test(int (*func)(struct halide_buffer_t *_input_buffer, struct halide_buffer_t *_output_buffer),
+         const int width = 1024, const int height = 768)
 {
     try {
         int ret = 0;
@@ -18,12 +22,10 @@ int test(int (*func)(struct halide_buffer_t *_input_buffer, struct halide_buffer
         //
         // Run
         //
-        const int width = 1024;
-        const int height = 768;
         const std::vector<int32_t> extents{width, height};
         auto input = mk_rand_buffer<T>(extents);
         auto output = mk_null_buffer<T>(extents);
-        T expect[width][height];
+        std::vector<std::vector<T>> expect(width, std::vector<T>(height));
 
         for (int y=0; y<height; ++y) {
             int yy0 = std::max(0, y - 1); //protect out of bounds
@@ -48,6 +50,7 @@ int test(int (*func)(struct halide_buffer_t *_input_buffer, struct halide_buffer
         }
 
         func(input, output);
+        bench(func, input, output);
 
 	// check expect match output
         for (int y=1; y<height; ++y) {
@@ -78,5 +81,13 @@ int main()
 #ifdef TYPE_u16
     test<uint16_t>(sobel_u16);
 #endif
+#ifdef TYPE_u8_tile
+    test<uint8_t>(sobel_u8_tile);
+#endif
+    // Size is taken from the buffers: VGA runs the specialized branch, and 1000 x 700 the generic one.
+#ifdef TYPE_u8_dynamic
+    test<uint8_t>(sobel_u8_dynamic, 640, 480);
+    test<uint8_t>(sobel_u8_dynamic, 1000, 700);
+#endif
 }
 
@@ -13,6 +13,7 @@
 #include "split3_i16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src_buffer,
@@ -42,6 +43,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer,
             }
         }
         func(input, output[0], output[1], output[2]);
+        bench(func, input, output[0], output[1], output[2]);
 
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
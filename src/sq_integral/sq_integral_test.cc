@@ -13,15 +13,16 @@
 #include "sq_integral_u8_f64.h"
 #include "sq_integral_u16_f64.h"
 #include "sq_integral_u32_f64.h"
+#include "sq_integral_u8_f64_narrow.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T, typename D>
-int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer))
+int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t *_dst_buffer),
+         const int width = 1024, const int height = 768)
 {
     try {
-        const int width = 1024;
-        const int height = 768;
         const std::vector<int32_t> extents{width, height};
         auto input = mk_rand_buffer<T>(extents);
         auto output = mk_null_buffer<D>(extents);
@@ -41,6 +42,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, struct halide_buffer_t
         }
 
         func(input, output);
+        bench(func, input, output);
 
         // for each x and y
         for (int y=0; y<height; ++y) {
@@ -80,4 +82,7 @@ int main()
 #ifdef TYPE_u32_f64
     test<uint32_t, double>(sq_integral_u32_f64);
 #endif
+#ifdef TYPE_u8_f64_narrow
+    test<uint8_t, double>(sq_integral_u8_f64_narrow, 100, 48);
+#endif
 }
@@ -16,6 +16,7 @@
 #include "sq_sum_u32_f64.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T, typename D>
 int test(int (*func)(struct halide_buffer_t *_src_buffer0,  struct halide_buffer_t *_dst_buffer))
@@ -36,6 +37,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer0,  struct halide_buffer
         double sum = 0.0;
 
         func(input, output);
+        bench(func, input, output);
         actual_total = output(0, 0);
 
         for (int y=0; y<height; ++y) {
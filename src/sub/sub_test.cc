@@ -11,6 +11,7 @@
 #include "sub_u32.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src_buffer0, struct halide_buffer_t *_src_buffer1, struct halide_buffer_t *_dst_buffer))
@@ -24,6 +25,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer0, struct halide_buffer_
         auto output = mk_null_buffer<T>(extents);
 
         func(input0, input1, output);
+        bench(func, input0, input1, output);
         //for each x and y
         for (int y=0; y<height; ++y) {
             for (int x=0; x<width; ++x) {
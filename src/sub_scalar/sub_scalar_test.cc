@@ -12,6 +12,7 @@
 #include "sub_scalar_u32.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 
 template<typename T>
@@ -26,6 +27,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer, double _value, struct
         auto output = mk_null_buffer<T>(extents);
 
         func(input, value, output);
+        bench(func, input, value, output);
         const double max_value = static_cast<double>(std::numeric_limits<T>::max());
 
         //for each x and y
@@ -4,6 +4,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class Subimage : public Halide::Generator<Subimage<T>> {
@@ -15,6 +16,7 @@ public:
 
     GeneratorParam<int32_t> out_width{"out_width", 500};
     GeneratorParam<int32_t> out_height{"out_height", 500};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Param<uint32_t> origin_x{"origin_x", 1};
     Param<uint32_t> origin_y{"origin_y", 1};
@@ -24,6 +26,7 @@ public:
         dst = Element::subimage<T>(src, origin_x, origin_y);
         schedule(src, {in_width, in_height});
         schedule(dst, {out_width, out_height});
+        schedule_cpu(dst, {out_width, out_height}, cpu_schedule, this->get_target());
 
         return dst;
     }
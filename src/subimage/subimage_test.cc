@@ -6,6 +6,7 @@
 #include "HalideRuntime.h"
 #include "HalideBuffer.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 #include "subimage_u8.h"
 #include "subimage_u16.h"
@@ -41,6 +42,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer,
         }
 
         func(input, origin_x, origin_y, output);
+        bench(func, input, origin_x, origin_y, output);
         //for each x and y
         for (int i=0; i<out_height; ++i) {
             for (int j=0; j<out_width; ++j) {
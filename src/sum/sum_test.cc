@@ -18,6 +18,7 @@
 #include "sum_f64_f64.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 using Halide::Element::SumType;
 
@@ -40,6 +41,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer0,  struct halide_buffer
         D expect_total = 0.0;
 	
         func(input, output);
+        bench(func, input, output);
         actual_total = output(0, 0);
 
         for (int y=0; y<height; ++y) {
@@ -11,6 +11,7 @@
 #include "threshold_min_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 Halide::Runtime::Buffer<T>& min_ref(Halide::Runtime::Buffer<T>& dst,
@@ -42,6 +43,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer,
         auto output = mk_null_buffer<T>(extents);
 
         func(input, threshold, output);
+        bench(func, input, threshold, output);
         auto expect = mk_rand_buffer<T>(extents);
         expect = min_ref(expect, input, width, height, threshold);
 
@@ -4,6 +4,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class TmSsd : public Halide::Generator<TmSsd<T>> {
@@ -15,6 +16,7 @@ public:
     GeneratorParam<int32_t> img_height{"img_height", 768};
     GeneratorParam<int32_t> tmp_width{"tmp_width", 16};
     GeneratorParam<int32_t> tmp_height{"tmp_height", 16};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
     Func build() {
         Func dst{"dst"};
@@ -27,6 +29,7 @@ public:
         schedule(src0, {img_width, img_height});
         schedule(src1, {tmp_width, tmp_height});
         schedule(dst, {res_width, res_height});
+        schedule_cpu(dst, {res_width, res_height}, cpu_schedule, this->get_target());
 
         return dst;
     }
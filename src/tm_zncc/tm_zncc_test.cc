@@ -12,6 +12,7 @@
 #include "tm_zncc_u32.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 template<typename T>
 int test(int (*func)(struct halide_buffer_t *_src0_buffer, struct halide_buffer_t *_src1_buffer, struct halide_buffer_t *_dst_buffer))
@@ -49,6 +50,7 @@ int test(int (*func)(struct halide_buffer_t *_src0_buffer, struct halide_buffer_
         }
 
         func(input0, input1, output);
+        bench(func, input0, input1, output);
 
         const double tmp_size = static_cast<double>(tmp_width * tmp_height);
         for (int y=0; y<res_height; ++y) {
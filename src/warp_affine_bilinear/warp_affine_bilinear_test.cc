@@ -11,6 +11,7 @@
 #include "warp_affine_bilinear_u16.h"
 
 #include "test_common.h"
+#include "bench_common.h"
 
 #define BORDER_INTERPOLATE(x, l) (x < 0 ? 0 : (x >= l ? l - 1 : x))
 
@@ -116,6 +117,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer,
         auto output = mk_null_buffer<T>(extents);
 
         func(input, border_value, transform, output);
+        bench(func, input, border_value, transform, output);
         auto expect = mk_null_buffer<T>(extents);
         expect = BL_ref(expect, input, width, height, border_value, border_type, transform);
 
@@ -6,6 +6,7 @@
 #include "HalideRuntime.h"
 #include "HalideBuffer.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 #include "warp_map_bicubic_u8.h"
 #include "warp_map_bicubic_u16.h"
@@ -128,6 +129,7 @@ int test(int (*func)(struct halide_buffer_t *_src_buffer0,
 
 
         func(input0, input1, input2, border_value, output);
+        bench(func, input0, input1, input2, border_value, output);
 
         auto expect = mk_null_buffer<T>(extents);
         expect = warp_map_bicubic_ref(expect, input0, input1, input2, border_value, border_type, width, height);
@@ -4,6 +4,7 @@
 
 using namespace Halide;
 using Halide::Element::schedule;
+using Halide::Element::schedule_cpu;
 
 template<typename T>
 class WarpPerspectiveNN : public Halide::Generator<WarpPerspectiveNN<T>> {
@@ -14,6 +15,7 @@ class WarpPerspectiveNN : public Halide::Generator<WarpPerspectiveNN<T>> {
 
     GeneratorParam<int32_t> width{"width", 1024};
     GeneratorParam<int32_t> height{"height", 768};
+    GeneratorParam<Element::CPUSchedule> cpu_schedule{"cpu_schedule", Element::CPUSchedule::None, Element::cpu_schedule_enum_map};
 
 
 public:
@@ -23,6 +25,7 @@ public:
         schedule(src, {width, height});
         schedule(transform, {9});
         schedule(dst, {width, height});
+        schedule_cpu(dst, {width, height}, cpu_schedule, this->get_target());
         return dst;
     }
 };
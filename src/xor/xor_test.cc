@@ -6,6 +6,7 @@
 #include "HalideRuntime.h"
 #include "HalideBuffer.h"
 #include "test_common.h"
+#include "bench_common.h"
 
 #include "xor_u8.h"
 #include "xor_u16.h"
@@ -25,6 +26,7 @@ int test(int (*func)(struct halide_buffer_t *_src0_buffer,
         auto output = mk_null_buffer<T>(extents);
 
         func(input0, input1, output);
+        bench(func, input0, input1, output);
         //for each x and y
         for (int j=0; j<height; ++j) {
             for (int i=0; i<width; ++i) {
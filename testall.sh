@@ -16,6 +16,10 @@ elif [ "${target_arg}" = "csim" ]; then
     target="test_csim"
 elif [ "${target_arg}" = "device" ]; then
     target="run"
+elif [ "${target_arg}" = "bench" ]; then
+    target="bench"
+elif [ "${target_arg}" = "profile" ]; then
+    target="profile"
 elif [ "${target_arg}" != "clean" ]; then
     echo "Unknown target : $target_arg" 1>&2
     exit 1 ;
@@ -38,6 +42,12 @@ else
     for dir in ${dirs}; do
         echo -e "            Testing : ${dir}"
         cd ${dir}
+        # Modules with their own Makefile (e.g. label) have no bench and profile targets
+        if [ "${target}" = "bench" -o "${target}" = "profile" ] && ! grep -q "common.mk" Makefile; then
+            echo -e "             Result : \e[33mSKIPPED\e[m\n"
+            cd ../
+            continue
+        fi
         log=`make -B $target 2>&1`
         ret="$?"
         echo "$log" > make_${target}.log